@@ -0,0 +1,90 @@
+#pragma once
+#ifndef TETRA_META_BENCH_BENCHMARK_HPP
+#define TETRA_META_BENCH_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+/**
+ * A single named benchmark, registered statically with the
+ * TETRA_BENCHMARK macro.
+ **/
+struct BenchmarkCase
+{
+  std::string name;
+  void ( *run )();
+};
+
+/**
+ * Returns the program-lifetime list of registered benchmarks.
+ **/
+std::vector<BenchmarkCase>& registry();
+
+/**
+ * Adds a benchmark to the registry during static initialization.
+ **/
+struct Registrar
+{
+  inline Registrar( const char* name, void ( *run )() )
+  {
+    registry().push_back( {name, run} );
+  }
+};
+
+/**
+ * Wall-clock stopwatch, started on construction.
+ **/
+class Timer
+{
+  using Clock = std::chrono::steady_clock;
+
+  Clock::time_point start{Clock::now()};
+
+public:
+  inline void reset() { start = Clock::now(); }
+
+  inline double seconds() const
+  {
+    return std::chrono::duration<double>( Clock::now() - start )
+      .count();
+  }
+};
+
+/**
+ * Prints one result row. items and bytes are optional, when non-zero
+ * the matching throughput column is printed too.
+ **/
+void report( const std::string& label, double seconds,
+             std::size_t items = 0, std::size_t bytes = 0 );
+
+/**
+ * Keeps the optimizer from discarding a computed value.
+ **/
+template <typename T>
+inline void doNotOptimize( const T& value )
+{
+  asm volatile( "" : : "g"( &value ) : "memory" );
+}
+
+} /* namespace bench */
+
+#define TETRA_BENCHMARK_CONCAT2( a, b ) a##b
+#define TETRA_BENCHMARK_CONCAT( a, b ) TETRA_BENCHMARK_CONCAT2( a, b )
+
+/**
+ * Declares and registers a benchmark body:
+ *   TETRA_BENCHMARK( "name" ) { ... }
+ **/
+#define TETRA_BENCHMARK( name )                                      \
+  static void TETRA_BENCHMARK_CONCAT( benchmark_, __LINE__ )();     \
+  static ::bench::Registrar TETRA_BENCHMARK_CONCAT( registrar_,      \
+                                                    __LINE__ ){      \
+    name, &TETRA_BENCHMARK_CONCAT( benchmark_, __LINE__ )};          \
+  static void TETRA_BENCHMARK_CONCAT( benchmark_, __LINE__ )()
+
+#endif
@@ -0,0 +1,44 @@
+#include <Benchmark.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+vector<bench::BenchmarkCase>& bench::registry()
+{
+  static vector<BenchmarkCase> cases;
+  return cases;
+}
+
+void bench::report( const string& label, double seconds,
+                    size_t items, size_t bytes )
+{
+  printf( "  %-44s %10.3f ms", label.c_str(), seconds * 1e3 );
+  if ( items != 0 )
+    printf( "  %9.2f Mitem/s", items / seconds / 1e6 );
+  if ( bytes != 0 )
+    printf( "  %9.2f MB/s", bytes / seconds / 1e6 );
+  printf( "\n" );
+}
+
+/**
+ * Runs every registered benchmark, or only those whose name contains
+ * one of the command line arguments.
+ **/
+int main( int argc, char** argv )
+{
+  for ( const auto& benchmark : bench::registry() )
+  {
+    bool selected = argc < 2;
+    for ( int i = 1; i < argc; ++i )
+      selected |= strstr( benchmark.name.c_str(), argv[i] ) != nullptr;
+
+    if ( !selected ) continue;
+
+    printf( "%s\n", benchmark.name.c_str() );
+    benchmark.run();
+  }
+
+  return 0;
+}
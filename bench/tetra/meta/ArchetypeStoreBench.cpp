@@ -0,0 +1,92 @@
+#include <tetra/meta/ArchetypeStore.hpp>
+#include <tetra/meta/ComponentStore.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+struct Velocity
+{
+  float dx{1.0f}, dy{0.0f}, dz{0.0f};
+};
+
+struct Health
+{
+  int points{100};
+};
+
+} /* namespace */
+
+TETRA_BENCHMARK( "ArchetypeStore: position + velocity query" )
+{
+  const Entity count = 500000;
+  const int passes = 10;
+
+  // entities get their components in a shuffled order, and only
+  // some of them are moving or have health
+  vector<Entity> order( count );
+  for ( Entity entity = 0; entity < count; ++entity )
+    order[entity] = entity;
+  shuffle( order.begin(), order.end(), mt19937{11} );
+
+  ComponentStore components{};
+  ArchetypeStore archetypes{};
+  for ( Entity entity : order )
+  {
+    components.add<VectorComponent>( entity );
+    archetypes.add<VectorComponent>( entity );
+    if ( entity % 3 == 0 )
+    {
+      components.add<Health>( entity );
+      archetypes.add<Health>( entity );
+    }
+  }
+  for ( Entity entity : order )
+  {
+    if ( entity % 2 == 0 )
+    {
+      components.add<Velocity>( entity );
+      archetypes.add<Velocity>( entity );
+    }
+  }
+
+  {
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      components.forEach<Velocity>(
+        [&]( Entity entity, Velocity& velocity ) {
+          VectorComponent& position =
+            *components.get<VectorComponent>( entity );
+          position.setX( position.getX() + velocity.dx );
+        } );
+    }
+    bench::report( "ComponentStore, per-type arrays", timer.seconds(),
+                   size_t( count / 2 ) * passes );
+  }
+  {
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      archetypes.forEach<VectorComponent, Velocity>(
+        []( Entity, VectorComponent& position, Velocity& velocity ) {
+          position.setX( position.getX() + velocity.dx );
+        } );
+    }
+    bench::report( "ArchetypeStore, archetype chunks",
+                   timer.seconds(), size_t( count / 2 ) * passes );
+  }
+
+  bench::doNotOptimize( *archetypes.get<VectorComponent>( 0 ) );
+  bench::doNotOptimize( *components.get<VectorComponent>( 0 ) );
+}
@@ -0,0 +1,93 @@
+#include <tetra/meta/AtomicVariantSlot.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+const size_t operations = 1000000;
+
+// the blocking alternative
+template <typename T>
+class LockedSlot
+{
+  mutex lock;
+  T value{};
+
+public:
+  void store( const T& stored )
+  {
+    lock_guard<mutex> guard{lock};
+    value = stored;
+  }
+
+  template <typename U>
+  U load()
+  {
+    lock_guard<mutex> guard{lock};
+    return value;
+  }
+};
+
+// times loads and stores while both run at once
+template <typename T, typename Slot>
+void contend( const string& label, Slot& slot, const T& value )
+{
+  atomic<bool> done{false};
+  double writeSeconds = 0;
+  thread writer{[&]() {
+    bench::Timer timer{};
+    for ( size_t i = 0; i < operations; ++i ) slot.store( value );
+    writeSeconds = timer.seconds();
+    done = true;
+  }};
+
+  size_t reads = 0;
+  bench::Timer timer{};
+  while ( !done || reads < operations )
+  {
+    T loaded = slot.template load<T>();
+    bench::doNotOptimize( loaded );
+    ++reads;
+  }
+  double readSeconds = timer.seconds();
+  writer.join();
+
+  bench::report( label + " store", writeSeconds, operations );
+  bench::report( label + " load", readSeconds, reads );
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "AtomicVariantSlot: load/store under contention" )
+{
+  {
+    LockedSlot<VectorComponent> slot{};
+    contend( "mutex, VectorComponent", slot,
+             VectorComponent{1, 2, 3} );
+  }
+  {
+    AtomicVariantSlot slot{MetaData::get<VectorComponent>()};
+    contend( "seqlock, VectorComponent", slot,
+             VectorComponent{1, 2, 3} );
+  }
+  {
+    LockedSlot<string> slot{};
+    contend( "mutex, string", slot, string( 64, 'x' ) );
+  }
+  {
+    AtomicVariantSlot slot{MetaData::get<string>()};
+    contend( "triple buffer, string", slot, string( 64, 'x' ) );
+  }
+}
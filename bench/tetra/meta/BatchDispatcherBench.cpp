@@ -0,0 +1,109 @@
+#include <tetra/meta/BatchDispatcher.hpp>
+#include <tetra/meta/Dispatcher.hpp>
+
+#include <Benchmark.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+const int messageTypeCount = 64;
+
+template <int N>
+struct Batched
+{
+  long value{N};
+};
+
+// Registers handlers for Batched<N> ... Batched<Last - 1>, each doing
+// a little type specific work.
+template <int N, int Last>
+struct Register
+{
+  static void handlers( Dispatcher& dispatcher, long& sum )
+  {
+    dispatcher.addHandler<Batched<N>>(
+      [&sum]( Batched<N>& msg ) { sum += msg.value * N + ( N ^ 5 ); } );
+    Register<N + 1, Last>::handlers( dispatcher, sum );
+  }
+
+  static void handlers( BatchDispatcher& dispatcher, long& sum )
+  {
+    dispatcher.addHandler<Batched<N>>(
+      [&sum]( PayloadSpan<Batched<N>> span ) {
+        for ( auto& msg : span ) sum += msg.value * N + ( N ^ 5 );
+      } );
+    Register<N + 1, Last>::handlers( dispatcher, sum );
+  }
+
+  static Variant create( int type )
+  {
+    return type == N ? Variant::create( Batched<N>{} )
+                     : Register<N + 1, Last>::create( type );
+  }
+};
+
+template <int Last>
+struct Register<Last, Last>
+{
+  static void handlers( Dispatcher&, long& ) {}
+  static void handlers( BatchDispatcher&, long& ) {}
+  static Variant create( int ) { return {}; }
+};
+
+using AllBatched = Register<0, messageTypeCount>;
+
+void compare( const char* label, vector<Variant>& messages )
+{
+  const int passes = 5;
+  long sum = 0;
+
+  Dispatcher dispatcher{};
+  AllBatched::handlers( dispatcher, sum );
+  bench::Timer timer{};
+  for ( int pass = 0; pass < passes; ++pass )
+    for ( auto& msg : messages ) dispatcher.dispatch( msg );
+  bench::report( string{"Dispatcher, per element, "} + label,
+                 timer.seconds(), messages.size() * passes );
+
+  BatchDispatcher batchDispatcher{};
+  AllBatched::handlers( batchDispatcher, sum );
+  timer.reset();
+  for ( int pass = 0; pass < passes; ++pass )
+    batchDispatcher.dispatch( messages );
+  bench::report( string{"BatchDispatcher, grouped, "} + label,
+                 timer.seconds(), messages.size() * passes );
+
+  bench::doNotOptimize( sum );
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "BatchDispatcher: grouped vs per-element dispatch" )
+{
+  const size_t count = 1000000;
+
+  mt19937 random{7};
+  uniform_int_distribution<int> type{0, messageTypeCount - 1};
+
+  vector<Variant> messages;
+  messages.reserve( count );
+  for ( size_t i = 0; i < count; ++i )
+    messages.push_back( AllBatched::create( type( random ) ) );
+
+  // payloads allocated in arrival order are laid out in arrival order,
+  // which favours per element dispatch
+  compare( "allocation order", messages );
+
+  // messages from many producers arrive in an order unrelated to
+  // where their payloads were allocated
+  shuffle( messages.begin(), messages.end(), random );
+  compare( "scattered", messages );
+}
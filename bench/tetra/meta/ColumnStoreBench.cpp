@@ -0,0 +1,92 @@
+#include <tetra/meta/ColumnStore.hpp>
+#include <tetra/meta/ComponentStore.hpp>
+
+#include <Benchmark.hpp>
+
+#include <cstddef>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+/**
+ * A body with more state than the integration kernel needs, as is
+ * typical for components.
+ **/
+struct Body
+{
+  float x, y, z;
+  float vx, vy, vz;
+  float mass, drag;
+  int flags;
+};
+
+void reflect( FieldList<Body>& fields )
+{
+  fields.add( "x", &Body::x ).add( "y", &Body::y ).add( "z", &Body::z )
+        .add( "vx", &Body::vx ).add( "vy", &Body::vy )
+        .add( "vz", &Body::vz ).add( "mass", &Body::mass )
+        .add( "drag", &Body::drag ).add( "flags", &Body::flags );
+}
+
+void integrate( float* position, const float* velocity, float dt,
+                size_t count )
+{
+  for ( size_t i = 0; i < count; ++i ) position[i] += velocity[i] * dt;
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "ColumnStore: position integration, SoA vs AoS" )
+{
+  const size_t count = 1000000;
+  const int passes = 20;
+  const float dt = 0.016f;
+
+  ComponentStore rows{};
+  ColumnStore columns{MetaData::get<Body>()};
+  for ( Entity entity = 0; entity < count; ++entity )
+  {
+    Body body{0, 0, 0, 1, 2, 3, 1, 0, 0};
+    rows.add( entity, body );
+    columns.add( entity, body );
+  }
+
+  {
+    bench::Timer timer{};
+    ComponentView<Body> bodies = rows.components<Body>();
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      for ( Body& body : bodies )
+      {
+        body.x += body.vx * dt;
+        body.y += body.vy * dt;
+        body.z += body.vz * dt;
+      }
+    }
+    bench::report( "AoS, ComponentStore", timer.seconds(),
+                   count * passes );
+    bench::doNotOptimize( bodies[0] );
+  }
+  {
+    bench::Timer timer{};
+    float* x = columns.column( &Body::x );
+    float* y = columns.column( &Body::y );
+    float* z = columns.column( &Body::z );
+    const float* vx = columns.column( &Body::vx );
+    const float* vy = columns.column( &Body::vy );
+    const float* vz = columns.column( &Body::vz );
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      integrate( x, vx, dt, count );
+      integrate( y, vy, dt, count );
+      integrate( z, vz, dt, count );
+    }
+    bench::report( "SoA, ColumnStore", timer.seconds(),
+                   count * passes );
+    bench::doNotOptimize( x[0] );
+  }
+}
@@ -0,0 +1,56 @@
+#include <tetra/meta/CompactVariant.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+const size_t count = 2000000;
+const int passes = 5;
+
+template <typename V>
+void iterate( const char* label )
+{
+  vector<V> variants;
+  variants.reserve( count );
+  for ( size_t i = 0; i < count; ++i )
+    variants.push_back( V::create( VectorComponent{1.0f, 2.0f, 3.0f} ) );
+
+  // visit in an order unrelated to allocation order, like a long
+  // lived container would
+  mt19937 random{5};
+  shuffle( variants.begin(), variants.end(), random );
+
+  float sum = 0;
+  bench::Timer timer{};
+  for ( int pass = 0; pass < passes; ++pass )
+  {
+    for ( const auto& variant : variants )
+    {
+      const VectorComponent* value =
+        variant.template tryGetObject<VectorComponent>();
+      if ( value != nullptr ) sum += value->getX();
+    }
+  }
+  bench::report( label, timer.seconds(), count * passes,
+                 count * passes * sizeof( V ) );
+  bench::doNotOptimize( sum );
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "CompactVariant: checked iteration vs Variant" )
+{
+  iterate<Variant>( "vector<Variant>, 16 byte handles" );
+  iterate<CompactVariant>( "vector<CompactVariant>, 8 byte handles" );
+}
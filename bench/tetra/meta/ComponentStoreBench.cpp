@@ -0,0 +1,59 @@
+#include <tetra/meta/ComponentStore.hpp>
+#include <tetra/meta/Variant.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+TETRA_BENCHMARK( "ComponentStore: iterate components vs Variants" )
+{
+  const size_t count = 1000000;
+  const int passes = 10;
+
+  // Variants created in churned order, like components which were
+  // added and removed over time, so payloads are scattered
+  mt19937 random{3};
+  vector<Variant> variants;
+  vector<string> churn;
+  for ( size_t i = 0; i < count; ++i )
+  {
+    variants.push_back(
+      Variant::create( VectorComponent{1.0f, 2.0f, 3.0f} ) );
+    churn.push_back( string( random() % 64, 'x' ) );
+  }
+  shuffle( variants.begin(), variants.end(), random );
+  churn.clear();
+
+  ComponentStore store{};
+  for ( Entity entity = 0; entity < count; ++entity )
+    store.add( entity, VectorComponent{1.0f, 2.0f, 3.0f} );
+
+  {
+    float sum = 0;
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+      for ( const auto& variant : variants )
+        sum += variant.getObject<VectorComponent>().getX();
+    bench::report( "vector<Variant> + getObject", timer.seconds(),
+                   count * passes );
+    bench::doNotOptimize( sum );
+  }
+  {
+    float sum = 0;
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+      for ( const auto& vec : store.components<VectorComponent>() )
+        sum += vec.getX();
+    bench::report( "ComponentStore::components", timer.seconds(),
+                   count * passes );
+    bench::doNotOptimize( sum );
+  }
+}
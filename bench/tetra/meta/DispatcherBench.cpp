@@ -0,0 +1,91 @@
+#include <tetra/meta/Dispatcher.hpp>
+
+#include <Benchmark.hpp>
+
+#include <random>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+const int messageTypeCount = 200;
+
+template <int N>
+struct Message
+{
+  long value{N};
+};
+
+// Registers a handler for each of Message<N> ... Message<Last - 1>.
+template <int N, int Last>
+struct Register
+{
+  static void handlers( Dispatcher& dispatcher, long& sum )
+  {
+    dispatcher.addHandler<Message<N>>(
+      [&sum]( Message<N>& msg ) { sum += msg.value; } );
+    Register<N + 1, Last>::handlers( dispatcher, sum );
+  }
+
+  static Variant create( int type )
+  {
+    return type == N ? Variant::create( Message<N>{} )
+                     : Register<N + 1, Last>::create( type );
+  }
+
+  // The if/else chain which the README used to recommend.
+  static void ifChain( const Variant& msg, long& sum )
+  {
+    if ( msg.getMetaData() == MetaData::get<Message<N>>() )
+      sum += msg.getObject<Message<N>>().value;
+    else
+      Register<N + 1, Last>::ifChain( msg, sum );
+  }
+};
+
+template <int Last>
+struct Register<Last, Last>
+{
+  static void handlers( Dispatcher&, long& ) {}
+  static Variant create( int ) { return {}; }
+  static void ifChain( const Variant&, long& ) {}
+};
+
+using AllMessages = Register<0, messageTypeCount>;
+
+} /* namespace */
+
+TETRA_BENCHMARK( "Dispatcher: 200 message types vs if/else chain" )
+{
+  const size_t count = 1000000;
+
+  mt19937 random{42};
+  uniform_int_distribution<int> type{0, messageTypeCount - 1};
+
+  vector<Variant> messages;
+  messages.reserve( count );
+  for ( size_t i = 0; i < count; ++i )
+    messages.push_back( AllMessages::create( type( random ) ) );
+
+  long sum = 0;
+  Dispatcher dispatcher{};
+  AllMessages::handlers( dispatcher, sum );
+
+  {
+    sum = 0;
+    bench::Timer timer{};
+    for ( auto& msg : messages ) AllMessages::ifChain( msg, sum );
+    bench::report( "if/else chain", timer.seconds(), count );
+    bench::doNotOptimize( sum );
+  }
+  {
+    sum = 0;
+    bench::Timer timer{};
+    for ( auto& msg : messages ) dispatcher.dispatch( msg );
+    bench::report( "Dispatcher", timer.seconds(), count );
+    bench::doNotOptimize( sum );
+  }
+}
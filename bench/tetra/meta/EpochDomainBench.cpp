@@ -0,0 +1,82 @@
+#include <tetra/meta/EpochDomain.hpp>
+#include <tetra/meta/SharedVariant.hpp>
+
+#include <Benchmark.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+const size_t readCount = 2000000;
+const size_t readsPerPin = 64;
+
+template <typename Reader>
+double readConcurrently( unsigned threads, Reader reader )
+{
+  bench::Timer timer{};
+  vector<thread> readers;
+  for ( unsigned i = 0; i < threads; ++i ) readers.emplace_back( reader );
+  for ( auto& thread : readers ) thread.join();
+
+  return timer.seconds();
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "EpochDomain: shared reads vs reference counting" )
+{
+  SharedVariant shared = SharedVariant::create( string( 32, 'x' ) );
+  EpochDomain domain{};
+
+  for ( unsigned threads : {1u, 2u, 4u} )
+  {
+    string suffix = ", " + to_string( threads ) + " readers";
+
+    double seconds = readConcurrently( threads, [&shared]() {
+      size_t total = 0;
+      for ( size_t i = 0; i < readCount; ++i )
+      {
+        SharedVariant reference = shared;
+        total += reference.getObject<string>().size();
+      }
+      bench::doNotOptimize( total );
+    } );
+    bench::report( "SharedVariant copy per read" + suffix, seconds,
+                   readCount * threads );
+
+    const string* payload = &shared.getObject<string>();
+    seconds = readConcurrently( threads, [&domain, payload]() {
+      EpochDomain::Participant participant{domain};
+      size_t total = 0;
+      for ( size_t i = 0; i < readCount; i += readsPerPin )
+      {
+        auto guard = participant.pin();
+        for ( size_t j = 0; j < readsPerPin; ++j )
+          total += payload->size();
+      }
+      bench::doNotOptimize( total );
+    } );
+    bench::report( "EpochDomain pin per 64 reads" + suffix, seconds,
+                   readCount * threads );
+
+    seconds = readConcurrently( threads, [&domain, payload]() {
+      EpochDomain::Participant participant{domain};
+      size_t total = 0;
+      for ( size_t i = 0; i < readCount; ++i )
+      {
+        auto guard = participant.pin();
+        total += payload->size();
+      }
+      bench::doNotOptimize( total );
+    } );
+    bench::report( "EpochDomain pin per read" + suffix, seconds,
+                   readCount * threads );
+  }
+}
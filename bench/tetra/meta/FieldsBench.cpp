@@ -0,0 +1,101 @@
+#include <tetra/meta/Fields.hpp>
+#include <tetra/meta/Variant.hpp>
+
+#include <Benchmark.hpp>
+#include <json/json.h>
+#include <test/VectorComponent.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+/**
+ * VectorComponent's layout, with generated serializers only.
+ **/
+struct ReflectedVector
+{
+  float x, y, z;
+};
+
+void reflect( FieldList<ReflectedVector>& fields )
+{
+  fields.add( "x", &ReflectedVector::x )
+        .add( "y", &ReflectedVector::y )
+        .add( "z", &ReflectedVector::z );
+}
+
+template <typename T>
+void serializeLoop( const char* label, T value, size_t count )
+{
+  Variant variant = Variant::create( value );
+  Json::Value root{};
+  variant.serialize( root );
+
+  {
+    bench::Timer timer{};
+    for ( size_t i = 0; i < count; ++i )
+    {
+      Json::Value out{};
+      variant.serialize( out );
+      bench::doNotOptimize( out );
+    }
+    bench::report( string{label} + ", serialize", timer.seconds(),
+                   count );
+  }
+  {
+    bench::Timer timer{};
+    for ( size_t i = 0; i < count; ++i )
+      variant.deserialize( root );
+    bench::report( string{label} + ", deserialize", timer.seconds(),
+                   count );
+  }
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "Fields: generated vs hand written JSON serializers" )
+{
+  const size_t count = 200000;
+
+  serializeLoop( "hand written", VectorComponent{1.0f, 2.0f, 3.0f},
+                 count );
+  serializeLoop( "generated", ReflectedVector{1.0f, 2.0f, 3.0f},
+                 count );
+}
+
+TETRA_BENCHMARK( "Fields: binary format vs JSON" )
+{
+  const size_t count = 200000;
+  Variant variant =
+    Variant::create( ReflectedVector{1.0f, 2.0f, 3.0f} );
+
+  {
+    bench::Timer timer{};
+    Json::Value root{};
+    for ( size_t i = 0; i < count; ++i )
+    {
+      variant.serialize( root );
+      variant.deserialize( root );
+    }
+    bench::report( "JSON round trip", timer.seconds(), count );
+  }
+  {
+    bench::Timer timer{};
+    string buffer;
+    for ( size_t i = 0; i < count; ++i )
+    {
+      buffer.clear();
+      variant.writeBinary( buffer );
+      const char* begin = buffer.data();
+      variant.readBinary( begin, begin + buffer.size() );
+    }
+    bench::report( "binary round trip", timer.seconds(), count );
+  }
+  bench::doNotOptimize( variant.getObject<ReflectedVector>() );
+}
@@ -0,0 +1,88 @@
+#include <tetra/meta/MetaRepository.hpp>
+
+#include <Benchmark.hpp>
+#include <json/json.h>
+#include <test/VectorComponent.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+TETRA_BENCHMARK( "MetaRepository: batch vs per-element (de)serialize" )
+{
+  MetaRepository repository{};
+  repository.addType<VectorComponent>(
+    "tetra::test::VectorComponent" ); // long enough to allocate
+
+  const size_t count = 200000;
+  vector<Variant> variants;
+  variants.reserve( count );
+  for ( size_t i = 0; i < count; ++i )
+    variants.push_back(
+      Variant::create( VectorComponent{float( i ), 0.0f, 1.0f} ) );
+
+  Json::Value array{};
+  {
+    bench::Timer timer{};
+    for ( size_t i = 0; i < count; ++i )
+      repository.serialize( variants[i],
+                            array[Json::ArrayIndex( i )] );
+    bench::report( "serialize, per element", timer.seconds(), count );
+  }
+  {
+    Json::Value batch{};
+    bench::Timer timer{};
+    repository.serializeMany( variants.begin(), variants.end(),
+                              batch );
+    bench::report( "serializeMany", timer.seconds(), count );
+  }
+  {
+    vector<Variant> loaded;
+    bench::Timer timer{};
+    for ( const auto& element : array )
+      loaded.push_back( repository.deserialize( element ) );
+    bench::report( "deserialize, per element", timer.seconds(),
+                   count );
+  }
+  {
+    bench::Timer timer{};
+    vector<Variant> loaded = repository.deserializeMany( array );
+    bench::report( "deserializeMany", timer.seconds(), count );
+  }
+}
+
+TETRA_BENCHMARK( "MetaRepository: deserialize vs deserializeInto" )
+{
+  MetaRepository repository{};
+  repository.addType<VectorComponent>( "vector3d" );
+
+  Json::Value root{};
+  repository.serialize(
+    Variant::create( VectorComponent{1.0f, 2.0f, 3.0f} ), root );
+
+  const size_t count = 1000000;
+  {
+    bench::Timer timer{};
+    for ( size_t i = 0; i < count; ++i )
+    {
+      Variant message = repository.deserialize( root );
+      bench::doNotOptimize( message );
+    }
+    bench::report( "deserialize, new Variant each time",
+                   timer.seconds(), count );
+  }
+  {
+    Variant message{};
+    bench::Timer timer{};
+    for ( size_t i = 0; i < count; ++i )
+    {
+      repository.deserializeInto( message, root );
+      bench::doNotOptimize( message );
+    }
+    bench::report( "deserializeInto, reused Variant", timer.seconds(),
+                   count );
+  }
+}
@@ -0,0 +1,52 @@
+#include <tetra/meta/ParallelLoader.hpp>
+
+#include <Benchmark.hpp>
+#include <json/json.h>
+#include <test/VectorComponent.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+TETRA_BENCHMARK( "ParallelLoader: NDJSON scaling by thread count" )
+{
+  MetaRepository repository{};
+  repository.addType<VectorComponent>( "vector3d" );
+
+  const size_t lineCount = 200000;
+
+  Json::FastWriter writer{};
+  string input{};
+  for ( size_t i = 0; i < lineCount; ++i )
+  {
+    Json::Value root{};
+    repository.serialize(
+      Variant::create( VectorComponent{float( i ), 1.5f, -2.0f} ),
+      root );
+    input += writer.write( root );
+  }
+
+  for ( unsigned threads : {1u, 2u, 4u, 8u, 16u} )
+  {
+    for ( auto ordering : {ParallelLoader::Ordering::InputOrder,
+                           ParallelLoader::Ordering::Unordered} )
+    {
+      ParallelLoader loader{repository, threads};
+
+      bench::Timer timer{};
+      vector<Variant> variants = loader.load( input, ordering );
+      double seconds = timer.seconds();
+
+      bench::doNotOptimize( variants );
+      bench::report(
+        to_string( threads ) + " threads, " +
+          ( ordering == ParallelLoader::Ordering::InputOrder
+              ? "input order"
+              : "unordered" ),
+        seconds, variants.size(), input.size() );
+    }
+  }
+}
@@ -0,0 +1,125 @@
+#include <tetra/meta/ArchetypeStore.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <random>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+const int tagCount = 10;
+
+template <int N>
+struct Tag
+{
+  char value{0};
+};
+
+template <int N>
+struct Tags
+{
+  // adds Tag<N> ... Tag<tagCount - 1> for the set bits of mask
+  static void add( ArchetypeStore& store, Entity entity, int mask )
+  {
+    if ( mask & ( 1 << N ) ) store.add<Tag<N>>( entity );
+    Tags<N + 1>::add( store, entity, mask );
+  }
+
+  static void query( ArchetypeStore& store )
+  {
+    store.query<VectorComponent, Tag<N>>();
+    Tags<N + 1>::query( store );
+  }
+};
+
+template <>
+struct Tags<tagCount>
+{
+  static void add( ArchetypeStore&, Entity, int ) {}
+  static void query( ArchetypeStore& ) {}
+};
+
+/**
+ * Fills the store with entities spread over up to 2^tagCount
+ * archetypes, and returns the time it took.
+ **/
+double populate( ArchetypeStore& store, Entity count )
+{
+  mt19937 random{5};
+  bench::Timer timer{};
+  for ( Entity entity = 0; entity < count; ++entity )
+  {
+    store.add<VectorComponent>( entity );
+    if ( entity % 4 == 0 ) store.add<float>( entity );
+    Tags<0>::add( store, entity, random() % ( 1 << tagCount ) );
+  }
+
+  return timer.seconds();
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "Query: cached vs uncached, and maintenance cost" )
+{
+  const Entity count = 200000;
+  const int frames = 100;
+
+  ArchetypeStore plain{};
+  double plainSeconds = populate( plain, count );
+
+  ArchetypeStore queried{};
+  // eleven cached queries are kept up to date while populating
+  Tags<0>::query( queried );
+  const Query& query =
+    queried.query<VectorComponent, float, Tag<0>, Tag<1>>();
+  double queriedSeconds = populate( queried, count );
+
+  bench::report( "populate, no queries", plainSeconds, count );
+  bench::report( "populate, 11 cached queries", queriedSeconds,
+                 count );
+  printf( "  %zu archetypes, query matches %zu of them\n",
+          queried.getArchetypeCount(), query.getArchetypes().size() );
+
+  float sum = 0;
+  auto integrate = [&sum]( Entity, VectorComponent& position,
+                           float& speed, Tag<0>&, Tag<1>& ) {
+    position.setX( position.getX() + speed );
+    sum += speed;
+  };
+
+  {
+    bench::Timer timer{};
+    for ( int frame = 0; frame < frames; ++frame )
+      plain.forEach<VectorComponent, float, Tag<0>, Tag<1>>(
+        integrate );
+    bench::report( "forEach, every archetype examined",
+                   timer.seconds() / frames, query.size() );
+  }
+  {
+    bench::Timer timer{};
+    for ( int frame = 0; frame < frames; ++frame )
+      query.forEach<VectorComponent, float, Tag<0>, Tag<1>>(
+        integrate );
+    bench::report( "cached Query::forEach", timer.seconds() / frames,
+                   query.size() );
+  }
+  {
+    // churn existing archetypes, the matches need no maintenance
+    bench::Timer timer{};
+    for ( Entity entity = 0; entity < count; ++entity )
+    {
+      queried.remove<float>( entity );
+      queried.add<float>( entity );
+    }
+    bench::report( "add/remove churn with 11 cached queries",
+                   timer.seconds(), 2 * size_t( count ) );
+  }
+
+  bench::doNotOptimize( sum );
+}
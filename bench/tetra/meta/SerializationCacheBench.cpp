@@ -0,0 +1,127 @@
+#include <tetra/meta/SerializationCache.hpp>
+
+#include <Benchmark.hpp>
+#include <json/json.h>
+#include <test/VectorComponent.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+// changes one in every changeStride Variants, 5% of them
+const size_t changeStride = 20;
+
+void changeSome( vector<Variant>& variants, int pass )
+{
+  for ( size_t i = pass % changeStride; i < variants.size();
+        i += changeStride )
+  {
+    auto& vector = variants[i].getMutableObject<VectorComponent>();
+    vector.setX( vector.getX() + 1.0f );
+  }
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "SerializationCache: snapshots with 5% changed" )
+{
+  const size_t count = 20000;
+  const int passes = 10;
+
+  MetaRepository repository{};
+  repository.addType<VectorComponent>( "VectorComponent" );
+
+  vector<Variant> variants;
+  for ( size_t i = 0; i < count; ++i )
+    variants.push_back(
+      Variant::create( VectorComponent{float( i ), 2.0f, 3.0f} ) );
+
+  {
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      changeSome( variants, pass );
+      Json::Value array{};
+      repository.serializeMany( variants.begin(), variants.end(),
+                                array );
+      bench::doNotOptimize( array );
+    }
+    bench::report( "MetaRepository::serializeMany", timer.seconds(),
+                   count * passes );
+  }
+  {
+    SerializationCache cache{repository};
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      changeSome( variants, pass );
+      Json::Value array{};
+      cache.serializeMany( variants.begin(), variants.end(), array );
+      bench::doNotOptimize( array );
+    }
+    bench::report( "SerializationCache::serializeMany",
+                   timer.seconds(), count * passes );
+  }
+  {
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      changeSome( variants, pass );
+      Json::Value array{};
+      repository.serializeMany( variants.begin(), variants.end(),
+                                array );
+      string text = Json::FastWriter{}.write( array );
+      bench::doNotOptimize( text );
+    }
+    bench::report( "text, serializeMany + FastWriter", timer.seconds(),
+                   count * passes );
+  }
+  {
+    SerializationCache cache{repository};
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      changeSome( variants, pass );
+      string text;
+      for ( auto& variant : variants )
+        text += cache.serializeText( variant );
+      bench::doNotOptimize( text );
+    }
+    bench::report( "text, SerializationCache", timer.seconds(),
+                   count * passes );
+  }
+  {
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      changeSome( variants, pass );
+      string bytes;
+      for ( const auto& variant : variants )
+        variant.writeBinary( bytes );
+      bench::doNotOptimize( bytes );
+    }
+    bench::report( "binary, Variant::writeBinary", timer.seconds(),
+                   count * passes );
+  }
+  {
+    SerializationCache cache{repository};
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      changeSome( variants, pass );
+      string bytes;
+      for ( auto& variant : variants )
+        cache.writeBinary( variant, bytes );
+      bench::doNotOptimize( bytes );
+    }
+    bench::report( "binary, SerializationCache", timer.seconds(),
+                   count * passes );
+  }
+}
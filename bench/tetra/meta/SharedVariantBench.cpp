@@ -0,0 +1,43 @@
+#include <tetra/meta/SharedVariant.hpp>
+
+#include <Benchmark.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+TETRA_BENCHMARK( "SharedVariant: fan-out to 50 subscribers" )
+{
+  const size_t subscribers = 50;
+  const size_t messageCount = 2000;
+
+  for ( size_t payloadSize : {16u, 1024u, 65536u} )
+  {
+    string suffix = ", " + to_string( payloadSize ) + " byte payload";
+    vector<float> payload( payloadSize / sizeof( float ), 1.0f );
+
+    {
+      Variant message = Variant::create( payload );
+      vector<Variant> inboxes( subscribers );
+
+      bench::Timer timer{};
+      for ( size_t i = 0; i < messageCount; ++i )
+        for ( auto& inbox : inboxes ) inbox.copy( message );
+      bench::report( "Variant::copy" + suffix, timer.seconds(),
+                     messageCount * subscribers );
+    }
+    {
+      SharedVariant message = SharedVariant::create( payload );
+      vector<SharedVariant> inboxes( subscribers );
+
+      bench::Timer timer{};
+      for ( size_t i = 0; i < messageCount; ++i )
+        for ( auto& inbox : inboxes ) inbox = message;
+      bench::report( "SharedVariant" + suffix, timer.seconds(),
+                     messageCount * subscribers );
+    }
+  }
+}
@@ -0,0 +1,44 @@
+#include <tetra/meta/ParallelForEach.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <cmath>
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+TETRA_BENCHMARK( "TaskScheduler: parallelForEach scaling" )
+{
+  const size_t count = 1000000;
+  const int passes = 10;
+
+  ComponentStore store{};
+  for ( Entity entity = 0; entity < count; ++entity )
+    store.add( entity, VectorComponent{1.0f, 2.0f, 3.0f} );
+
+  auto update = []( Entity, VectorComponent& vector ) {
+    vector.setX( sqrt( vector.getX() * vector.getY() + vector.getZ() ) );
+  };
+
+  {
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+      store.forEach<VectorComponent>( update );
+    bench::report( "serial forEach", timer.seconds(), count * passes );
+  }
+
+  for ( unsigned threads : {1u, 2u, 4u, 8u, 16u} )
+  {
+    TaskScheduler scheduler{threads};
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+      parallelForEach<VectorComponent>( scheduler, store, update );
+    bench::report( "parallelForEach, " + to_string( threads ) +
+                     " threads",
+                   timer.seconds(), count * passes );
+  }
+}
@@ -0,0 +1,74 @@
+#include <tetra/meta/VariantArena.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+double iterate( const vector<Variant>& variants, int passes )
+{
+  float sum = 0;
+  bench::Timer timer{};
+  for ( int pass = 0; pass < passes; ++pass )
+  {
+    for ( const auto& variant : variants )
+    {
+      if ( auto* vector = variant.tryGetObject<VectorComponent>() )
+        sum += vector->getX();
+      else if ( auto* name = variant.tryGetObject<string>() )
+        sum += float( name->size() );
+    }
+  }
+  bench::doNotOptimize( sum );
+
+  return timer.seconds();
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "VariantArena: iteration before and after compaction" )
+{
+  const size_t count = 1000000;
+  const int passes = 10;
+
+  // simulate hours of churn: payloads allocated between unrelated
+  // allocations and the container reordered since
+  mt19937 random{11};
+  vector<Variant> variants;
+  vector<string> churn;
+  for ( size_t i = 0; i < count; ++i )
+  {
+    if ( i % 4 == 0 )
+      variants.push_back( Variant::create( string( 8, 'x' ) ) );
+    else
+      variants.push_back(
+        Variant::create( VectorComponent{1.0f, 2.0f, 3.0f} ) );
+    churn.push_back( string( random() % 64, 'x' ) );
+  }
+  shuffle( variants.begin(), variants.end(), random );
+  churn.clear();
+
+  bench::report( "scattered payloads", iterate( variants, passes ),
+                 count * passes );
+
+  VariantArena arena{};
+  bench::Timer timer{};
+  arena.compact( variants );
+  bench::report( "compact", timer.seconds(), count );
+
+  bench::report( "compacted payloads", iterate( variants, passes ),
+                 count * passes );
+
+  variants.clear();
+}
@@ -0,0 +1,103 @@
+#include <tetra/meta/VariantQueue.hpp>
+
+#include <Benchmark.hpp>
+
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+const size_t messageCount = 400000;
+
+// the queue this replaces in tetra-message
+class LockedQueue
+{
+  mutex lock;
+  deque<Variant> variants;
+
+public:
+  bool tryPush( Variant&& variant )
+  {
+    lock_guard<mutex> guard{lock};
+    variants.push_back( move( variant ) );
+    return true;
+  }
+
+  template <typename OutputIt>
+  size_t popBatch( OutputIt out, size_t maxCount )
+  {
+    lock_guard<mutex> guard{lock};
+    size_t count = 0;
+    for ( ; count < maxCount && !variants.empty(); ++count )
+    {
+      *out++ = move( variants.front() );
+      variants.pop_front();
+    }
+
+    return count;
+  }
+};
+
+template <typename Queue>
+double transfer( Queue& queue, unsigned producers )
+{
+  // payloads are created up front, only the transfer is timed
+  vector<vector<Variant>> outgoing( producers );
+  for ( auto& variants : outgoing )
+    for ( size_t i = 0; i < messageCount / producers; ++i )
+      variants.push_back( Variant::create( string( 32, 'x' ) ) );
+
+  bench::Timer timer{};
+  vector<thread> threads;
+  for ( auto& variants : outgoing )
+  {
+    threads.emplace_back( [&queue, &variants]() {
+      for ( auto& variant : variants )
+        while ( !queue.tryPush( move( variant ) ) )
+          this_thread::yield();
+    } );
+  }
+
+  vector<Variant> batch;
+  batch.reserve( 256 );
+  for ( size_t received = 0;
+        received < messageCount / producers * producers; )
+  {
+    batch.clear();
+    size_t count = queue.popBatch( back_inserter( batch ), 256 );
+    if ( count == 0 ) this_thread::yield();
+    received += count;
+  }
+
+  for ( auto& thread : threads ) thread.join();
+  return timer.seconds();
+}
+
+} /* namespace */
+
+TETRA_BENCHMARK( "VariantQueue: MPSC transfer vs mutex + deque" )
+{
+  for ( unsigned producers : {1u, 2u, 4u, 8u, 16u} )
+  {
+    string suffix = ", " + to_string( producers ) + " producers";
+    {
+      LockedQueue queue{};
+      bench::report( "mutex + deque" + suffix,
+                     transfer( queue, producers ), messageCount );
+    }
+    {
+      VariantQueue queue{4096};
+      bench::report( "VariantQueue" + suffix,
+                     transfer( queue, producers ), messageCount );
+    }
+  }
+}
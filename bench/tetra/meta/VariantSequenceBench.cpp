@@ -0,0 +1,69 @@
+#include <tetra/meta/VariantSequence.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+TETRA_BENCHMARK( "VariantSequence: per-frame message list" )
+{
+  const size_t messageCount = 10000;
+  const int frames = 200;
+
+  {
+    vector<Variant> messages;
+    float sum = 0;
+    bench::Timer timer{};
+    for ( int frame = 0; frame < frames; ++frame )
+    {
+      for ( size_t i = 0; i < messageCount; ++i )
+      {
+        if ( i % 2 == 0 )
+          messages.push_back( Variant::create( int( i ) ) );
+        else
+          messages.push_back(
+            Variant::create( VectorComponent{1.0f, 2.0f, 3.0f} ) );
+      }
+
+      for ( const auto& message : messages )
+      {
+        if ( auto* vector = message.tryGetObject<VectorComponent>() )
+          sum += vector->getX();
+      }
+      messages.clear();
+    }
+    bench::report( "vector<Variant>", timer.seconds(),
+                   messageCount * frames );
+    bench::doNotOptimize( sum );
+  }
+  {
+    VariantSequence messages{};
+    float sum = 0;
+    bench::Timer timer{};
+    for ( int frame = 0; frame < frames; ++frame )
+    {
+      for ( size_t i = 0; i < messageCount; ++i )
+      {
+        if ( i % 2 == 0 )
+          messages.append( int( i ) );
+        else
+          messages.append( VectorComponent{1.0f, 2.0f, 3.0f} );
+      }
+
+      for ( const auto& message : messages )
+      {
+        if ( auto* vector = message.tryGetObject<VectorComponent>() )
+          sum += vector->getX();
+      }
+      messages.clear();
+    }
+    bench::report( "VariantSequence", timer.seconds(),
+                   messageCount * frames );
+    bench::doNotOptimize( sum );
+  }
+}
@@ -0,0 +1,56 @@
+#include <tetra/meta/VariantArena.hpp>
+#include <tetra/meta/VariantSpan.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+TETRA_BENCHMARK( "VariantSpan: checked once vs getObject per element" )
+{
+  const size_t count = 1000000;
+  const int passes = 20;
+
+  vector<Variant> variants;
+  for ( size_t i = 0; i < count; ++i )
+    variants.push_back(
+      Variant::create( VectorComponent{1.0f, 2.0f, 3.0f} ) );
+
+  // contiguous payloads, so the loop cost rather than cache misses
+  // dominates
+  VariantArena arena{};
+  arena.compact( variants );
+
+  // independent updates, so neither loop is bound by a dependency
+  // chain through an accumulator
+  {
+    bench::Timer timer{};
+    for ( int pass = 0; pass < passes; ++pass )
+    {
+      for ( const auto& variant : variants )
+      {
+        auto& vector = variant.getObject<VectorComponent>();
+        vector.setX( vector.getX() * 0.5f + 1.0f );
+      }
+    }
+    bench::report( "getObject per element", timer.seconds(),
+                   count * passes );
+  }
+  {
+    bench::Timer timer{};
+    VariantSpan<VectorComponent> span{variants};
+    for ( int pass = 0; pass < passes; ++pass )
+      for ( auto& vector : span )
+        vector.setX( vector.getX() * 0.5f + 1.0f );
+    bench::report( "VariantSpan, checked once", timer.seconds(),
+                   count * passes );
+  }
+  bench::doNotOptimize( variants[0].getObject<VectorComponent>() );
+
+  variants.clear();
+}
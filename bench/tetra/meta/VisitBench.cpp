@@ -0,0 +1,122 @@
+#include <tetra/meta/Dispatcher.hpp>
+#include <tetra/meta/Visit.hpp>
+
+#include <Benchmark.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <random>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+/**
+ * What std::variant visitation compiles down to: a tag and a switch.
+ * std::variant itself needs C++17, and this library builds as C++11.
+ **/
+struct TaggedUnion
+{
+  enum class Tag
+  {
+    Int,
+    Float,
+    Double,
+    Vector
+  } tag;
+
+  union
+  {
+    int i;
+    float f;
+    double d;
+    VectorComponent vec;
+  };
+};
+
+} /* namespace */
+
+TETRA_BENCHMARK( "visit: closed set vs tagged union vs Dispatcher" )
+{
+  const size_t count = 2000000;
+
+  mt19937 random{7};
+  uniform_int_distribution<int> type{0, 3};
+
+  vector<Variant> variants;
+  vector<TaggedUnion> unions( count );
+  variants.reserve( count );
+  for ( size_t i = 0; i < count; ++i )
+  {
+    switch ( type( random ) )
+    {
+    case 0:
+      variants.push_back( Variant::create( 1 ) );
+      unions[i].tag = TaggedUnion::Tag::Int;
+      unions[i].i = 1;
+      break;
+    case 1:
+      variants.push_back( Variant::create( 2.0f ) );
+      unions[i].tag = TaggedUnion::Tag::Float;
+      unions[i].f = 2.0f;
+      break;
+    case 2:
+      variants.push_back( Variant::create( 3.0 ) );
+      unions[i].tag = TaggedUnion::Tag::Double;
+      unions[i].d = 3.0;
+      break;
+    default:
+      variants.push_back(
+        Variant::create( VectorComponent{4.0f, 0, 0} ) );
+      unions[i].tag = TaggedUnion::Tag::Vector;
+      unions[i].vec = VectorComponent{4.0f, 0, 0};
+      break;
+    }
+  }
+
+  double sum = 0;
+  {
+    bench::Timer timer{};
+    for ( const auto& u : unions )
+    {
+      switch ( u.tag )
+      {
+      case TaggedUnion::Tag::Int: sum += u.i; break;
+      case TaggedUnion::Tag::Float: sum += u.f; break;
+      case TaggedUnion::Tag::Double: sum += u.d; break;
+      case TaggedUnion::Tag::Vector: sum += u.vec.getX(); break;
+      }
+    }
+    bench::report( "tagged union switch", timer.seconds(), count );
+    bench::doNotOptimize( sum );
+  }
+  {
+    auto visitor = overloaded(
+      [&sum]( int& i ) { sum += i; }, [&sum]( float& f ) { sum += f; },
+      [&sum]( double& d ) { sum += d; },
+      [&sum]( VectorComponent& vec ) { sum += vec.getX(); } );
+
+    bench::Timer timer{};
+    for ( const auto& variant : variants )
+      visit<int, float, double, VectorComponent>( variant, visitor );
+    bench::report( "visit<int, float, double, VectorComponent>",
+                   timer.seconds(), count );
+    bench::doNotOptimize( sum );
+  }
+  {
+    Dispatcher dispatcher{};
+    dispatcher.addHandler<int>( [&sum]( int& i ) { sum += i; } );
+    dispatcher.addHandler<float>( [&sum]( float& f ) { sum += f; } );
+    dispatcher.addHandler<double>( [&sum]( double& d ) { sum += d; } );
+    dispatcher.addHandler<VectorComponent>(
+      [&sum]( VectorComponent& vec ) { sum += vec.getX(); } );
+
+    bench::Timer timer{};
+    for ( auto& variant : variants ) dispatcher.dispatch( variant );
+    bench::report( "Dispatcher", timer.seconds(), count );
+    bench::doNotOptimize( sum );
+  }
+}
@@ -0,0 +1,196 @@
+#pragma once
+#ifndef TETRA_META_ARCHETYPE_HPP
+#define TETRA_META_ARCHETYPE_HPP
+
+#include <tetra/meta/Entity.hpp>
+#include <tetra/meta/MetaData.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+class ArchetypeStore;
+
+/**
+ * Stores every entity which has exactly the same set of component
+ * types. Entities live in fixed-size chunks, and each chunk holds one
+ * column per component type plus a column of entities, so the
+ * components a query touches sit next to each other in memory.
+ * Rows are kept packed: only the last chunk may be partially filled.
+ **/
+class Archetype
+{
+  friend class ArchetypeStore;
+
+  struct Chunk
+  {
+    char* memory;
+    std::size_t count;
+  };
+
+  std::vector<const MetaData*> types; // sorted by type index
+  std::vector<std::size_t> offsets;   // column offsets in a chunk
+  std::size_t rowCapacity{0};
+  std::size_t chunkBytes{0};
+  std::size_t chunkAlignment{0};
+  std::vector<Chunk> chunks;
+
+  // archetype transitions, indexed by type index, filled lazily by
+  // the ArchetypeStore
+  std::vector<Archetype*> addEdges;
+  std::vector<Archetype*> removeEdges;
+
+public:
+  /**
+   * The number of bytes allocated for each chunk, unless a single row
+   * does not fit.
+   **/
+  static const std::size_t chunkSize = 16 * 1024;
+
+  /**
+   * Returned by columnOf for types which are not in the archetype.
+   **/
+  static const std::size_t noColumn = static_cast<std::size_t>( -1 );
+
+  /**
+   * Identifies a row: the chunk and the row within it.
+   **/
+  struct Location
+  {
+    std::size_t chunk;
+    std::size_t row;
+  };
+
+  /**
+   * Creates an archetype for the set of component types.
+   * @param types The component types, in any order, without
+   *        duplicates.
+   **/
+  explicit Archetype( std::vector<const MetaData*> types );
+
+  /**
+   * Destroys every component and frees the chunks.
+   **/
+  ~Archetype();
+
+  Archetype( const Archetype& ) = delete;
+  Archetype& operator=( const Archetype& ) = delete;
+
+  /**
+   * Returns the component types, sorted by type index.
+   **/
+  const std::vector<const MetaData*>& getTypes() const noexcept;
+
+  /**
+   * Returns the column holding the type, or noColumn.
+   **/
+  std::size_t columnOf( const MetaData& metaData ) const noexcept;
+
+  bool contains( const MetaData& metaData ) const noexcept
+  {
+    return columnOf( metaData ) != noColumn;
+  }
+
+  /**
+   * Returns the number of rows which fit into one chunk.
+   **/
+  std::size_t getRowCapacity() const noexcept;
+
+  std::size_t getChunkCount() const noexcept;
+
+  /**
+   * Returns the number of entities in the archetype.
+   **/
+  std::size_t size() const noexcept;
+
+  /**
+   * Returns the number of rows used in the chunk.
+   **/
+  std::size_t rowCount( std::size_t chunk ) const noexcept
+  {
+    return chunks[chunk].count;
+  }
+
+  /**
+   * Returns the first element of the column in the chunk, elements
+   * are the column type's size apart.
+   **/
+  void* column( std::size_t chunk, std::size_t column ) const noexcept
+  {
+    return chunks[chunk].memory + offsets[column + 1];
+  }
+
+  /**
+   * Returns the entity column of the chunk.
+   **/
+  Entity* entities( std::size_t chunk ) const noexcept
+  {
+    return reinterpret_cast<Entity*>( chunks[chunk].memory );
+  }
+
+  /**
+   * Returns the component of the column at the location.
+   **/
+  void* at( const Location& location, std::size_t column ) const
+    noexcept
+  {
+    return reinterpret_cast<char*>(
+             this->column( location.chunk, column ) ) +
+           location.row * types[column]->getSize();
+  }
+
+  /**
+   * Calls f( entity, Ts&... ) for every row, if the archetype
+   * contains all of the component types Ts.
+   **/
+  template <typename... Ts, typename F>
+  void forEach( F& f ) const
+  {
+    std::size_t columns[] = {columnOf( MetaData::get<Ts>() )...};
+    for ( std::size_t column : columns )
+      if ( column == noColumn ) return;
+
+    for ( std::size_t chunk = 0; chunk < chunks.size(); ++chunk )
+    {
+      forEachRow( f, entities( chunk ), chunks[chunk].count,
+                  reinterpret_cast<Ts*>( this->column(
+                    chunk, columnOf( MetaData::get<Ts>() ) ) )... );
+    }
+  }
+
+private:
+  template <typename F, typename... Ts>
+  static void forEachRow( F& f, const Entity* entities,
+                          std::size_t rows, Ts*... columns )
+  {
+    for ( std::size_t row = 0; row < rows; ++row )
+      f( entities[row], columns[row]... );
+  }
+
+  /**
+   * Appends a row for the entity, the components of the row are left
+   * uninitialized.
+   **/
+  Location pushRow( Entity entity );
+
+  /**
+   * Releases the last row, its components must be uninitialized.
+   **/
+  void popRow() noexcept;
+
+  /**
+   * Fills the row, whose components must be uninitialized, by
+   * relocating the last row into it.
+   * @return The location of the last row, which was moved.
+   **/
+  Location removeRow( const Location& location ) noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,180 @@
+#pragma once
+#ifndef TETRA_META_ARCHETYPESTORE_HPP
+#define TETRA_META_ARCHETYPESTORE_HPP
+
+#include <tetra/meta/Archetype.hpp>
+#include <tetra/meta/Query.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Stores entity components grouped by archetype, the set of component
+ * types an entity has. Queries over several component types only
+ * visit the archetypes which contain all of them, and find the
+ * components of each entity side by side in the same chunk.
+ * Adding or removing a component moves the entity to another
+ * archetype by relocating its components, so pointers to components
+ * are invalidated by add and remove.
+ **/
+class ArchetypeStore
+{
+  struct Record
+  {
+    Archetype* archetype;
+    Archetype::Location location;
+  };
+
+  std::vector<std::unique_ptr<Archetype>> archetypes;
+  std::map<std::vector<const MetaData*>, Archetype*> archetypeIndex;
+  std::vector<Record> records; // indexed by entity
+
+  std::vector<std::unique_ptr<Query>> queries;
+  std::map<std::vector<const MetaData*>, Query*> queryIndex;
+
+public:
+  ArchetypeStore() = default;
+  ArchetypeStore( const ArchetypeStore& ) = delete;
+  ArchetypeStore& operator=( const ArchetypeStore& ) = delete;
+
+  /**
+   * Adds a default constructed component of the type to the entity,
+   * does nothing if the entity already has one.
+   * @throws InvalidEntityException if the entity is above maxEntity.
+   * @return The entity's component.
+   **/
+  void* add( Entity entity, const MetaData& metaData );
+
+  template <typename T>
+  T& add( Entity entity )
+  {
+    return *reinterpret_cast<T*>( add( entity, MetaData::get<T>() ) );
+  }
+
+  /**
+   * Adds the component to the entity, replacing the value of the
+   * entity's existing component of the same type.
+   * @throws InvalidEntityException if the entity is above maxEntity.
+   * @return The entity's component.
+   **/
+  template <typename T>
+  typename std::remove_reference<T>::type& add( Entity entity,
+                                                T&& component )
+  {
+    using Type = typename std::remove_reference<T>::type;
+    Type& stored = add<Type>( entity );
+    stored = std::forward<T>( component );
+
+    return stored;
+  }
+
+  /**
+   * Removes the entity's component of the type.
+   * @return false if the entity had no such component.
+   **/
+  bool remove( Entity entity, const MetaData& metaData );
+
+  template <typename T>
+  bool remove( Entity entity )
+  {
+    return remove( entity, MetaData::get<T>() );
+  }
+
+  /**
+   * Removes every component of the entity.
+   **/
+  void removeAll( Entity entity ) noexcept;
+
+  /**
+   * Returns the entity's component of the type, nullptr if it has
+   * none.
+   **/
+  void* get( Entity entity, const MetaData& metaData ) const noexcept;
+
+  template <typename T>
+  T* get( Entity entity ) const noexcept
+  {
+    return reinterpret_cast<T*>( get( entity, MetaData::get<T>() ) );
+  }
+
+  template <typename T>
+  bool has( Entity entity ) const noexcept
+  {
+    return get<T>( entity ) != nullptr;
+  }
+
+  /**
+   * Returns the archetype the entity belongs to, nullptr if the
+   * entity has no components.
+   **/
+  const Archetype* getArchetype( Entity entity ) const noexcept;
+
+  /**
+   * Returns the number of archetypes created so far. Archetypes are
+   * kept even when they become empty.
+   **/
+  std::size_t getArchetypeCount() const noexcept;
+
+  /**
+   * Returns the cached query for the entities having all of the
+   * types. The query lives as long as the store, asking for the same
+   * set of types again returns the same query.
+   * Creating a query examines every existing archetype once, after
+   * that the store keeps the query's matches up to date as new
+   * archetypes are created.
+   **/
+  const Query& query( std::vector<const MetaData*> types );
+
+  template <typename... Ts>
+  const Query& query()
+  {
+    return query( {&MetaData::get<Ts>()...} );
+  }
+
+  /**
+   * Calls f( entity, Ts&... ) for every entity which has all of the
+   * component types Ts. Every archetype is examined, prefer a cached
+   * query when the same types are visited repeatedly.
+   * The callable must not add or remove components.
+   **/
+  template <typename... Ts, typename F>
+  void forEach( F f ) const
+  {
+    for ( const auto& archetype : archetypes )
+      archetype->forEach<Ts...>( f );
+  }
+
+private:
+  /**
+   * Returns the archetype with the type added to, or removed from,
+   * the archetype's types, creating it if necessary.
+   * from may be nullptr, which stands for no components.
+   **/
+  Archetype* withType( Archetype* from, const MetaData& metaData );
+  Archetype* withoutType( Archetype* from, const MetaData& metaData );
+  Archetype* findOrCreate( std::vector<const MetaData*> types );
+
+  /**
+   * Moves the entity to the target archetype, relocating each
+   * component the two archetypes share and destroying the rest. The
+   * target's components which the source lacks must be constructed
+   * by the caller, at the returned location, before this is called
+   * again.
+   **/
+  void moveEntity( Entity entity, Archetype* target,
+                   Archetype::Location targetLocation ) noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef TETRA_META_ATOMICVARIANTSLOT_HPP
+#define TETRA_META_ATOMICVARIANTSLOT_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Holds the latest value of a single type, published by one writer
+ * thread and read by other threads without blocking the writer.
+ * Trivially copyable types are kept in a seqlock: the writer never
+ * waits, and any number of readers copy the bytes, retrying only if a
+ * store overlapped the copy. Other types, whose copy may not be
+ * interrupted, are kept in a triple buffer: the writer fills a spare
+ * instance and swaps it in, and the reader swaps out the freshest
+ * one. Both sides are wait-free, but only one thread may load from a
+ * triple buffered slot.
+ * Stores and loads pass on exceptions thrown by copying the type, a
+ * store which throws publishes nothing.
+ **/
+class AtomicVariantSlot
+{
+  static constexpr unsigned freshBit = 4;
+
+  const MetaData* metaData;
+
+  // seqlock
+  std::atomic<std::size_t> sequence{0};
+  void* bytes{nullptr};
+
+  // triple buffer, the middle index and freshBit are shared
+  Variant buffers[3];
+  unsigned back{0};
+  std::atomic<unsigned> middle{1};
+  unsigned front{2};
+
+public:
+  /**
+   * Creates a slot holding a default constructed instance of the type
+   * that the MetaData describes.
+   **/
+  explicit AtomicVariantSlot( const MetaData& metaData );
+
+  ~AtomicVariantSlot();
+
+  AtomicVariantSlot( const AtomicVariantSlot& ) = delete;
+  AtomicVariantSlot& operator=( const AtomicVariantSlot& ) = delete;
+
+  /**
+   * Returns the MetaData of the type held by the slot.
+   **/
+  const MetaData& getMetaData() const noexcept;
+
+  /**
+   * Returns true if the slot uses the seqlock, and so may be loaded
+   * by several threads.
+   **/
+  bool isSeqLocked() const noexcept;
+
+  /**
+   * Publishes a copy of the Variant's payload. Only one thread may
+   * store at a time.
+   * @throws TypeCastException if the Variant holds another type.
+   **/
+  void store( const Variant& value );
+
+  /**
+   * Copies the latest published value into the Variant, which is
+   * given a payload of the slot's type first if it holds another.
+   **/
+  void load( Variant& out );
+
+  template <typename T>
+  void store( const T& value )
+  {
+    if ( metaData != &MetaData::get<T>() )
+    {
+      throw TypeCastException{};
+    }
+
+    storePayload( &value );
+  }
+
+  template <typename T>
+  T load()
+  {
+    if ( metaData != &MetaData::get<T>() )
+    {
+      throw TypeCastException{};
+    }
+
+    T value{};
+    loadPayload( &value );
+    return value;
+  }
+
+private:
+  void storePayload( const void* payload );
+  void loadPayload( void* payload );
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,225 @@
+#pragma once
+#ifndef TETRA_META_BATCHDISPATCHER_HPP
+#define TETRA_META_BATCHDISPATCHER_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * The payloads of one type, as handed to a BatchDispatcher handler.
+ **/
+template <typename T>
+class PayloadSpan
+{
+  void* const* first;
+  std::size_t count;
+
+public:
+  class Iterator
+  {
+    void* const* current;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    explicit Iterator( void* const* current ) noexcept
+      : current{current}
+    { }
+
+    T& operator*() const noexcept
+    {
+      return *reinterpret_cast<T*>( *current );
+    }
+
+    T* operator->() const noexcept
+    {
+      return reinterpret_cast<T*>( *current );
+    }
+
+    T& operator[]( difference_type n ) const noexcept
+    {
+      return *reinterpret_cast<T*>( current[n] );
+    }
+
+    Iterator& operator++() noexcept { ++current; return *this; }
+    Iterator& operator--() noexcept { --current; return *this; }
+
+    Iterator operator++( int ) noexcept
+    {
+      return Iterator{current++};
+    }
+
+    Iterator operator--( int ) noexcept
+    {
+      return Iterator{current--};
+    }
+
+    Iterator& operator+=( difference_type n ) noexcept
+    {
+      current += n;
+      return *this;
+    }
+
+    Iterator& operator-=( difference_type n ) noexcept
+    {
+      current -= n;
+      return *this;
+    }
+
+    Iterator operator+( difference_type n ) const noexcept
+    {
+      return Iterator{current + n};
+    }
+
+    Iterator operator-( difference_type n ) const noexcept
+    {
+      return Iterator{current - n};
+    }
+
+    friend Iterator operator+( difference_type n,
+                               const Iterator& iter ) noexcept
+    {
+      return iter + n;
+    }
+
+    difference_type operator-( const Iterator& rhs ) const noexcept
+    {
+      return current - rhs.current;
+    }
+
+    bool operator==( const Iterator& rhs ) const noexcept
+    {
+      return current == rhs.current;
+    }
+
+    bool operator!=( const Iterator& rhs ) const noexcept
+    {
+      return current != rhs.current;
+    }
+
+    bool operator<( const Iterator& rhs ) const noexcept
+    {
+      return current < rhs.current;
+    }
+
+    bool operator>( const Iterator& rhs ) const noexcept
+    {
+      return current > rhs.current;
+    }
+
+    bool operator<=( const Iterator& rhs ) const noexcept
+    {
+      return current <= rhs.current;
+    }
+
+    bool operator>=( const Iterator& rhs ) const noexcept
+    {
+      return current >= rhs.current;
+    }
+  };
+
+  PayloadSpan( void* const* first, std::size_t count ) noexcept
+    : first{first}, count{count}
+  { }
+
+  Iterator begin() const noexcept { return Iterator{first}; }
+  Iterator end() const noexcept { return Iterator{first + count}; }
+  std::size_t size() const noexcept { return count; }
+
+  T& operator[]( std::size_t i ) const noexcept
+  {
+    return *reinterpret_cast<T*>( first[i] );
+  }
+};
+
+/**
+ * Routes a collection of Variants to handlers one type at a time.
+ * The Variants are grouped by MetaData::getTypeIndex with a counting
+ * sort, which is linear and stable, and each handler is called once
+ * with every payload of its type in arrival order. Running one
+ * handler over many payloads keeps its code and branches hot, where
+ * dispatching in arrival order jumps to a different handler for
+ * nearly every message.
+ * - Note: dispatch is not reentrant, handlers must not call dispatch
+ *   on the same BatchDispatcher, as the batch in progress lives in
+ *   buffers which every dispatch reuses. Use a second dispatcher, or
+ *   collect the Variants and dispatch them after the call returns.
+ **/
+class BatchDispatcher
+{
+  using Handler = std::function<void( void* const*, std::size_t )>;
+  using Fallback = std::function<void( Variant& )>;
+
+  std::vector<Handler> handlers;
+  Fallback fallback;
+
+  // reused between dispatches, which is why dispatch is not
+  // reentrant
+  std::vector<std::size_t> slots;
+  std::vector<std::size_t> offsets;
+  std::vector<void*> payloads;
+
+public:
+  /**
+   * Registers the handler to be called with the payloads of the
+   * dispatched Variants holding a T. Replaces any handler which was
+   * previously registered for T.
+   * @param handler Callable as handler( PayloadSpan<T> ).
+   **/
+  template <typename T, typename F>
+  void addHandler( F handler )
+  {
+    addHandler( MetaData::get<T>(),
+                [handler]( void* const* first, std::size_t count ) {
+                  handler( PayloadSpan<T>{first, count} );
+                } );
+  }
+
+  /**
+   * Sets the handler which is called, in arrival order, with each
+   * Variant that no typed handler was registered for, including
+   * empty Variants.
+   **/
+  void setFallback( Fallback fallback );
+
+  /**
+   * Returns true if a typed handler was registered for the type.
+   **/
+  bool handles( const MetaData& metaData ) const noexcept;
+
+  /**
+   * Groups the Variants by type and calls each type's handler once,
+   * in type index order, then the fallback for unhandled Variants.
+   * Must not be called from the handlers of this dispatcher.
+   * @return The number of Variants passed to typed handlers.
+   **/
+  std::size_t dispatch( Variant* first, Variant* last );
+
+  std::size_t dispatch( std::vector<Variant>& messages )
+  {
+    return dispatch( messages.data(),
+                     messages.data() + messages.size() );
+  }
+
+private:
+  void addHandler( const MetaData& metaData, Handler handler );
+  std::size_t slotOf( const Variant& message ) const noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,261 @@
+#pragma once
+#ifndef TETRA_META_COLUMNSTORE_HPP
+#define TETRA_META_COLUMNSTORE_HPP
+
+#include <tetra/meta/Entity.hpp>
+#include <tetra/meta/Fields.hpp>
+#include <tetra/meta/MetaData.hpp>
+#include <tetra/meta/Variant.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Thrown when a ColumnStore is created for a type which is not
+ * trivially copyable or has no reflected fields.
+ **/
+class ColumnLayoutException : public std::runtime_error
+{
+public:
+  inline ColumnLayoutException()
+    : std::runtime_error{"Type can not be stored in columns!"}
+  { }
+};
+
+template <typename T>
+class ColumnRef;
+
+/**
+ * Stores the components of one reflected, trivially copyable type as
+ * a structure of arrays: every reflected field gets its own densely
+ * packed, cache line aligned column. Kernels which only need some of
+ * the fields touch only those columns, and a column of floats can be
+ * processed at full SIMD width.
+ * Entities map to slots like in ComponentStore, removing a component
+ * moves the last slot into its place.
+ * - Note: data members which are not reflected are not stored.
+ **/
+class ColumnStore
+{
+  static const std::uint32_t noSlot = 0xFFFFFFFF;
+
+  struct Column
+  {
+    const Field* field;
+    std::size_t size;
+    char* data;
+  };
+
+  const MetaData* metaData;
+  std::vector<Column> columns;
+  std::vector<Entity> owners;        // slot -> entity
+  std::vector<std::uint32_t> slots;  // entity -> slot
+  std::size_t capacity{0};
+
+public:
+  /**
+   * Returned by find for entities without a component.
+   **/
+  static const std::size_t npos = static_cast<std::size_t>( -1 );
+
+  /**
+   * @throws ColumnLayoutException if the type is not trivially
+   *         copyable or has no reflected fields.
+   **/
+  explicit ColumnStore( const MetaData& metaData );
+
+  ColumnStore( const ColumnStore& ) = delete;
+  ColumnStore& operator=( const ColumnStore& ) = delete;
+
+  ~ColumnStore();
+
+  const MetaData& getMetaData() const noexcept;
+
+  /**
+   * Returns the number of components.
+   **/
+  std::size_t size() const noexcept;
+
+  /**
+   * Returns the number of columns, one per reflected field.
+   **/
+  std::size_t getColumnCount() const noexcept;
+
+  /**
+   * Returns the field stored in the column.
+   **/
+  const Field& getField( std::size_t column ) const noexcept;
+
+  /**
+   * Returns the start of the column, aligned to a cache line.
+   **/
+  void* getColumn( std::size_t column ) const noexcept;
+
+  /**
+   * Returns the entities owning the components, indexed by slot.
+   **/
+  const Entity* getOwners() const noexcept;
+
+  /**
+   * Splits the component's fields into the columns, replacing the
+   * entity's existing component.
+   * @param value Points to an instance of the store's type.
+   * @throws InvalidEntityException if the entity is above maxEntity.
+   * @return The component's slot.
+   **/
+  std::size_t add( Entity entity, const void* value );
+
+  template <typename T>
+  std::size_t add( Entity entity, const T& value )
+  {
+    checkType<T>();
+    return add( entity, static_cast<const void*>( &value ) );
+  }
+
+  /**
+   * Removes the entity's component.
+   * @return false if the entity had none.
+   **/
+  bool remove( Entity entity ) noexcept;
+
+  /**
+   * Returns the slot of the entity's component, npos if it has none.
+   **/
+  std::size_t find( Entity entity ) const noexcept;
+
+  bool has( Entity entity ) const noexcept
+  {
+    return find( entity ) != npos;
+  }
+
+  /**
+   * Gathers the fields of the component in the slot into value.
+   **/
+  void load( std::size_t slot, void* value ) const noexcept;
+
+  /**
+   * Scatters the fields of value into the slot.
+   **/
+  void store( std::size_t slot, const void* value ) noexcept;
+
+  /**
+   * Returns the column of the data member.
+   * @throws TypeCastException if T is not the store's type or the
+   *         member is not reflected.
+   **/
+  template <typename F, typename T>
+  F* column( F T::*member ) const
+  {
+    checkType<T>();
+    return reinterpret_cast<F*>(
+      getColumn( findColumn( memberOffset( member ),
+                             MetaData::get<F>() ) ) );
+  }
+
+  /**
+   * Returns the column of the field with the name, for data members
+   * which are not accessible.
+   * @throws TypeCastException if there is no such field or it is not
+   *         an F.
+   **/
+  template <typename F>
+  F* column( const std::string& name ) const
+  {
+    const Field* field = metaData->getFields()->find( name );
+    if ( field == nullptr ) throw TypeCastException{};
+
+    return reinterpret_cast<F*>(
+      getColumn( findColumn( field->offset, MetaData::get<F>() ) ) );
+  }
+
+  /**
+   * Returns a proxy reference to the component in the slot.
+   * @throws TypeCastException if T is not the store's type.
+   **/
+  template <typename T>
+  ColumnRef<T> at( std::size_t slot )
+  {
+    checkType<T>();
+    return ColumnRef<T>{*this, slot};
+  }
+
+private:
+  template <typename T>
+  void checkType() const
+  {
+    static_assert( std::is_trivially_copyable<T>::value,
+                   "ColumnStore requires trivially copyable types" );
+    if ( &MetaData::get<T>() != metaData ) throw TypeCastException{};
+  }
+
+  /**
+   * Returns the index of the column at the offset.
+   * @throws TypeCastException if there is none or it does not hold
+   *         the type.
+   **/
+  std::size_t findColumn( std::size_t offset,
+                          const MetaData& type ) const;
+
+  void reserve( std::size_t minimum );
+};
+
+/**
+ * Stands in for a T& to a component in a ColumnStore. The fields
+ * live in separate columns, so single fields are accessed through
+ * field and whole components are gathered and scattered by
+ * conversion and assignment.
+ **/
+template <typename T>
+class ColumnRef
+{
+  ColumnStore* store;
+  std::size_t slot;
+
+public:
+  ColumnRef( ColumnStore& store, std::size_t slot ) noexcept
+    : store{&store}, slot{slot}
+  { }
+
+  /**
+   * Returns the data member of the component.
+   **/
+  template <typename F>
+  F& field( F T::*member ) const
+  {
+    return store->column( member )[slot];
+  }
+
+  /**
+   * Gathers the component, members which are not reflected are value
+   * initialized.
+   **/
+  operator T() const noexcept
+  {
+    T value{};
+    store->load( slot, &value );
+    return value;
+  }
+
+  /**
+   * Scatters the value into the component.
+   **/
+  const ColumnRef& operator=( const T& value ) const noexcept
+  {
+    store->store( slot, &value );
+    return *this;
+  }
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,167 @@
+#pragma once
+#ifndef TETRA_META_COMPACTVARIANT_HPP
+#define TETRA_META_COMPACTVARIANT_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * A Variant which is a single pointer wide.
+ * The payload is allocated together with a header holding its
+ * MetaData pointer, directly in front of the payload, so containers
+ * of CompactVariants are half the size of containers of Variants and
+ * checking the type touches the same cache line as the payload.
+ **/
+class CompactVariant
+{
+  // points at the payload, the header is in front of it
+  void* pObj{nullptr};
+
+public:
+  /**
+   * Creates an empty CompactVariant.
+   **/
+  CompactVariant() = default;
+
+  /**
+   * Creates a new CompactVariant which holds a default constructed
+   * instance of the class that the provided MetaData describes.
+   **/
+  explicit CompactVariant( const MetaData& metaData );
+
+  /**
+   * Creates a CompactVariant holding a copy of the object.
+   **/
+  template <typename T>
+  static CompactVariant create( T&& toStore )
+  {
+    using Type = typename std::remove_reference<T>::type;
+    CompactVariant v{MetaData::get<Type>()};
+    v.getObject<Type>() = std::forward<T>( toStore );
+
+    return v;
+  }
+
+  /**
+   * Safely deletes the object using its MetaData.
+   **/
+  ~CompactVariant();
+
+  CompactVariant( const CompactVariant& ) = delete;
+  CompactVariant& operator=( const CompactVariant& ) = delete;
+
+  /**
+   * The CompactVariant that is left behind is empty.
+   **/
+  CompactVariant( CompactVariant&& variant ) noexcept;
+  CompactVariant& operator=( CompactVariant&& variant ) noexcept;
+
+  /**
+   * Copies the payload and type of the provided variant.
+   **/
+  void copy( const CompactVariant& variant );
+
+  /**
+   * Copies the payload and type of the provided Variant.
+   **/
+  void copy( const Variant& variant );
+
+  /**
+   * Returns the MetaData which describes the payload, nullptr for
+   * empty CompactVariants.
+   **/
+  const MetaData* getMetaData() const noexcept
+  {
+    return pObj == nullptr ? nullptr : header( pObj );
+  }
+
+  /**
+   * Returns true if this CompactVariant holds no payload.
+   **/
+  bool isEmpty() const noexcept
+  {
+    return pObj == nullptr;
+  }
+
+  /**
+   * Returns true if this CompactVariant holds an instance of the type
+   * that the MetaData describes.
+   **/
+  bool holds( const MetaData& metaData ) const noexcept
+  {
+    return getMetaData() == &metaData;
+  }
+
+  /**
+   * Safely casts the payload to the type requested.
+   * @throws TypeCastException if the type requested is incompatable
+   *         with the type of the payload.
+   **/
+  template <typename T>
+  T& getObject() const
+  {
+    T* obj = tryGetObject<T>();
+    if ( obj == nullptr )
+    {
+      throw TypeCastException{};
+    }
+
+    return *obj;
+  }
+
+  /**
+   * Casts the payload to the type requested, or returns nullptr if
+   * the type requested is incompatable with the type of the payload.
+   **/
+  template <typename T>
+  T* tryGetObject() const noexcept
+  {
+    if ( !holds( MetaData::get<T>() ) )
+    {
+      return nullptr;
+    }
+
+    return reinterpret_cast<T*>( pObj );
+  }
+
+  /**
+   * Returns the unmanaged pointer to the payload, nullptr for empty
+   * CompactVariants.
+   **/
+  void* getPayload() const noexcept
+  {
+    return pObj;
+  }
+
+  /**
+   * Serializes the object into the Json::Value node.
+   * @return false if the object does not support serialization.
+   **/
+  bool serialize( Json::Value& root ) const;
+
+  /**
+   * Deserializes the object from the Json::Value node.
+   * @return false if the object does not support serialization.
+   **/
+  bool deserialize( const Json::Value& root );
+
+private:
+  static const MetaData*& header( void* payload ) noexcept
+  {
+    return reinterpret_cast<const MetaData**>( payload )[-1];
+  }
+
+  void reset() noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
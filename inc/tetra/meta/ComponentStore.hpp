@@ -0,0 +1,190 @@
+#pragma once
+#ifndef TETRA_META_COMPONENTSTORE_HPP
+#define TETRA_META_COMPONENTSTORE_HPP
+
+#include <tetra/meta/Entity.hpp>
+#include <tetra/meta/MetaArray.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * A contiguous range of the components of one type, along with the
+ * entity which owns each component.
+ **/
+template <typename T>
+class ComponentView
+{
+  T* first;
+  const Entity* owners;
+  std::size_t count;
+
+public:
+  ComponentView( T* first, const Entity* owners,
+                 std::size_t count ) noexcept
+    : first{first}, owners{owners}, count{count}
+  { }
+
+  T* begin() const noexcept { return first; }
+  T* end() const noexcept { return first + count; }
+  std::size_t size() const noexcept { return count; }
+  T& operator[]( std::size_t i ) const noexcept { return first[i]; }
+
+  /**
+   * Returns the entity which owns the component at index i.
+   **/
+  Entity entity( std::size_t i ) const noexcept { return owners[i]; }
+};
+
+/**
+ * Stores entity components grouped by type. Each type gets one densely
+ * packed MetaArray, so iterating over all components of a type is a
+ * linear scan of contiguous memory. A sparse set maps entities to
+ * their slot in each array.
+ * Removing a component moves the last component of that type into
+ * its slot, so pointers to components are invalidated by add and
+ * remove.
+ **/
+class ComponentStore
+{
+  static const std::uint32_t noSlot = 0xFFFFFFFF;
+
+  struct Pool
+  {
+    MetaArray components;
+    std::vector<Entity> owners;        // slot -> entity
+    std::vector<std::uint32_t> slots;  // entity -> slot
+
+    explicit Pool( const MetaData& metaData ) : components{metaData}
+    { }
+  };
+
+  // indexed by MetaData::getTypeIndex
+  std::vector<std::unique_ptr<Pool>> pools;
+
+public:
+  /**
+   * Adds a default constructed component of the type to the entity,
+   * does nothing if the entity already has one.
+   * @throws InvalidEntityException if the entity is above maxEntity.
+   * @return The entity's component.
+   **/
+  void* add( Entity entity, const MetaData& metaData );
+
+  template <typename T>
+  T& add( Entity entity )
+  {
+    return *reinterpret_cast<T*>( add( entity, MetaData::get<T>() ) );
+  }
+
+  /**
+   * Adds the component to the entity, replacing the value of the
+   * entity's existing component of the same type.
+   * @throws InvalidEntityException if the entity is above maxEntity.
+   * @return The entity's component.
+   **/
+  template <typename T>
+  typename std::remove_reference<T>::type& add( Entity entity,
+                                                T&& component )
+  {
+    using Type = typename std::remove_reference<T>::type;
+    Type& stored = add<Type>( entity );
+    stored = std::forward<T>( component );
+
+    return stored;
+  }
+
+  /**
+   * Removes the entity's component of the type.
+   * @return false if the entity had no such component.
+   **/
+  bool remove( Entity entity, const MetaData& metaData ) noexcept;
+
+  template <typename T>
+  bool remove( Entity entity ) noexcept
+  {
+    return remove( entity, MetaData::get<T>() );
+  }
+
+  /**
+   * Removes every component of the entity.
+   **/
+  void removeAll( Entity entity ) noexcept;
+
+  /**
+   * Returns the entity's component of the type, nullptr if it has
+   * none.
+   **/
+  void* get( Entity entity, const MetaData& metaData ) const noexcept;
+
+  template <typename T>
+  T* get( Entity entity ) const noexcept
+  {
+    return reinterpret_cast<T*>( get( entity, MetaData::get<T>() ) );
+  }
+
+  template <typename T>
+  bool has( Entity entity ) const noexcept
+  {
+    return get<T>( entity ) != nullptr;
+  }
+
+  /**
+   * Returns the number of components of the type.
+   **/
+  std::size_t size( const MetaData& metaData ) const noexcept;
+
+  /**
+   * Returns the array holding every component of the type, nullptr if
+   * no component of the type was ever added.
+   **/
+  const MetaArray* getArray( const MetaData& metaData ) const noexcept;
+
+  /**
+   * Returns the entities owning the components of the type, in the
+   * same order as the components in getArray.
+   **/
+  const Entity* getOwners( const MetaData& metaData ) const noexcept;
+
+  /**
+   * Returns a contiguous view of every component of type T.
+   **/
+  template <typename T>
+  ComponentView<T> components() const noexcept
+  {
+    const MetaArray* array = getArray( MetaData::get<T>() );
+    if ( array == nullptr ) return {nullptr, nullptr, 0};
+
+    return {reinterpret_cast<T*>( array->data() ),
+            getOwners( MetaData::get<T>() ), array->size()};
+  }
+
+  /**
+   * Calls f( entity, component ) for every component of type T.
+   * The callable must not add or remove components of type T.
+   **/
+  template <typename T, typename F>
+  void forEach( F f ) const
+  {
+    ComponentView<T> view = components<T>();
+    for ( std::size_t i = 0; i < view.size(); ++i )
+      f( view.entity( i ), view[i] );
+  }
+
+private:
+  Pool* findPool( const MetaData& metaData ) const noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
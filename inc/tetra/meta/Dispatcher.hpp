@@ -0,0 +1,72 @@
+#pragma once
+#ifndef TETRA_META_DISPATCHER_HPP
+#define TETRA_META_DISPATCHER_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Routes Variants to handlers registered for their payload type.
+ * Handlers live in a table indexed by MetaData::getTypeIndex, so a
+ * dispatch costs the same no matter how many types are handled.
+ **/
+class Dispatcher
+{
+  using Handler = std::function<void( void* )>;
+  using Fallback = std::function<void( Variant& )>;
+
+  std::vector<Handler> handlers;
+  Fallback fallback;
+
+public:
+  /**
+   * Registers the handler to be called with the payload of each
+   * dispatched Variant holding a T. Replaces any handler which was
+   * previously registered for T.
+   * @templateParam T The payload type to handle.
+   * @param handler Callable as handler( T& ).
+   **/
+  template <typename T, typename F>
+  void addHandler( F handler )
+  {
+    addHandler( MetaData::get<T>(), [handler]( void* obj ) {
+      handler( *reinterpret_cast<T*>( obj ) );
+    } );
+  }
+
+  /**
+   * Sets the handler which is called with Variants that no typed
+   * handler was registered for, including empty Variants.
+   * @param fallback Callable as fallback( Variant& ).
+   **/
+  void setFallback( Fallback fallback );
+
+  /**
+   * Returns true if a typed handler was registered for the type.
+   **/
+  bool handles( const MetaData& metaData ) const noexcept;
+
+  /**
+   * Calls the handler registered for the Variant's payload type. If
+   * there isn't one then the fallback is called instead, if it was
+   * set.
+   * @param message The Variant to dispatch.
+   * @return true if a typed handler was called.
+   **/
+  bool dispatch( Variant& message ) const;
+
+private:
+  void addHandler( const MetaData& metaData, Handler handler );
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef TETRA_META_ENTITY_HPP
+#define TETRA_META_ENTITY_HPP
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Identifies an entity in the component stores. Entities are plain
+ * numbers chosen by the caller, the stores size their indices by the
+ * largest entity used, so keep them small and dense.
+ **/
+using Entity = std::uint32_t;
+
+/**
+ * The largest entity the stores accept, the one above it marks empty
+ * slots.
+ **/
+const Entity maxEntity = 0xFFFFFFFE;
+
+/**
+ * Thrown when a component is added to an entity above maxEntity.
+ **/
+class InvalidEntityException : public std::runtime_error
+{
+public:
+  inline InvalidEntityException()
+    : std::runtime_error{"Entity is out of range!"}
+  { }
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
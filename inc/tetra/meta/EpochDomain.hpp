@@ -0,0 +1,163 @@
+#pragma once
+#ifndef TETRA_META_EPOCHDOMAIN_HPP
+#define TETRA_META_EPOCHDOMAIN_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Epoch based reclamation of Variants shared between threads.
+ * Each thread which reads shared Variants registers a Participant,
+ * and pins it for the duration of a read. A Variant which has been
+ * unlinked from the shared structure is retired instead of destroyed,
+ * its payload is destroyed only once every participant which was
+ * pinned when it was retired has unpinned.
+ * Pinning costs one store and one fence, reads made while pinned need
+ * no atomic read-modify-write at all.
+ **/
+class EpochDomain
+{
+public:
+  class Participant;
+
+  /**
+   * Keeps the Participant pinned, so no Variant retired from now on
+   * is destroyed, for as long as it exists. Guards of one
+   * Participant may nest.
+   **/
+  class Guard
+  {
+    Participant* participant;
+
+  public:
+    explicit Guard( Participant& participant ) noexcept;
+    ~Guard();
+
+    Guard( Guard&& guard ) noexcept;
+    Guard( const Guard& ) = delete;
+    Guard& operator=( const Guard& ) = delete;
+    Guard& operator=( Guard&& ) = delete;
+  };
+
+  /**
+   * A thread's registration with the domain, which must only be used
+   * by the thread that created it.
+   **/
+  class Participant
+  {
+    friend class EpochDomain;
+    friend class Guard;
+
+    struct Retired
+    {
+      std::size_t epoch;
+      Variant variant;
+    };
+
+    EpochDomain* domain;
+
+    // the epoch this participant is pinned in, 0 while unpinned
+    std::atomic<std::size_t> pinnedEpoch{0};
+    std::size_t pinCount{0};
+    std::vector<Retired> retired;
+
+  public:
+    /**
+     * Registers the participant with the domain.
+     **/
+    explicit Participant( EpochDomain& domain );
+
+    /**
+     * Unregisters the participant, Variants it retired which cannot
+     * be destroyed yet are handed to the domain.
+     **/
+    ~Participant();
+
+    Participant( const Participant& ) = delete;
+    Participant& operator=( const Participant& ) = delete;
+
+    /**
+     * Pins the participant until the returned Guard is destroyed.
+     **/
+    Guard pin() noexcept;
+
+    /**
+     * Returns true while a Guard of this participant exists.
+     **/
+    bool isPinned() const noexcept;
+
+    /**
+     * Takes the Variant, which must no longer be reachable by threads
+     * which pin after this call, and destroys its payload once no
+     * participant can still be reading it.
+     * @param variant Left empty.
+     **/
+    void retire( Variant&& variant );
+
+    /**
+     * Tries to advance the epoch and destroys the Variants retired by
+     * this participant which are no longer readable.
+     * @return The number of Variants destroyed.
+     **/
+    std::size_t collect();
+
+    /**
+     * Returns the number of Variants retired by this participant and
+     * not yet destroyed.
+     **/
+    std::size_t getRetiredCount() const noexcept;
+  };
+
+private:
+  // retired Variants which wait after retire() before collection
+  static constexpr std::size_t collectInterval = 64;
+
+  std::atomic<std::size_t> epoch{1};
+
+  std::mutex participantsMutex;
+  std::vector<Participant*> participants;
+  std::vector<Participant::Retired> orphans;
+
+public:
+  EpochDomain() = default;
+
+  /**
+   * Destroys every retired Variant. All participants must have been
+   * destroyed first.
+   **/
+  ~EpochDomain() = default;
+
+  EpochDomain( const EpochDomain& ) = delete;
+  EpochDomain& operator=( const EpochDomain& ) = delete;
+
+  /**
+   * Returns the current epoch.
+   **/
+  std::size_t getEpoch() const noexcept;
+
+  /**
+   * Advances the epoch if every pinned participant has observed the
+   * current one.
+   * @return true if the epoch was advanced.
+   **/
+  bool tryAdvance();
+
+private:
+  static std::size_t
+  reclaim( std::vector<Participant::Retired>& retired,
+           std::size_t epoch );
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
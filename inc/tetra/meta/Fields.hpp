@@ -0,0 +1,294 @@
+#pragma once
+#ifndef TETRA_META_FIELDS_HPP
+#define TETRA_META_FIELDS_HPP
+
+#include <tetra/meta/MetaData.hpp>
+
+#include <json/json.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Converts one field type to and from JSON and the binary format.
+ **/
+struct FieldCodec
+{
+  void ( *toJson )( const void* field, Json::Value& value );
+  bool ( *fromJson )( void* field, const Json::Value& value );
+  void ( *toBinary )( const void* field, std::string& out );
+  bool ( *fromBinary )( void* field, const char*& begin,
+                        const char* end );
+};
+
+/**
+ * Provides the FieldCodec for fields of type F. Arithmetic types and
+ * std::string are supported.
+ **/
+template <typename F, typename Enable = void>
+struct FieldCodecFor
+{
+  static_assert( std::is_arithmetic<F>::value,
+                 "Reflected fields must be arithmetic or std::string" );
+};
+
+template <typename F>
+struct FieldCodecFor<
+  F, typename std::enable_if<std::is_arithmetic<F>::value>::type>
+{
+  // the type jsoncpp stores F as
+  using JsonType = typename std::conditional<
+    std::is_same<F, bool>::value, bool,
+    typename std::conditional<
+      std::is_floating_point<F>::value, double,
+      typename std::conditional<std::is_signed<F>::value, Json::Int64,
+                                Json::UInt64>::type>::type>::type;
+
+  static const FieldCodec& get()
+  {
+    static const FieldCodec codec{toJson, fromJson, toBinary,
+                                  fromBinary};
+    return codec;
+  }
+
+  static void toJson( const void* field, Json::Value& value )
+  {
+    value = Json::Value{JsonType( *reinterpret_cast<const F*>( field ) )};
+  }
+
+  static bool fromJson( void* field, const Json::Value& value )
+  {
+    if ( std::is_same<F, bool>::value ? !value.isBool()
+                                      : !value.isNumeric() )
+      return false;
+    if ( !fits( value, JsonType{} ) ) return false;
+
+    *reinterpret_cast<F*>( field ) = F( read( value, JsonType{} ) );
+    return true;
+  }
+
+  static void toBinary( const void* field, std::string& out )
+  {
+    out.append( reinterpret_cast<const char*>( field ), sizeof( F ) );
+  }
+
+  static bool fromBinary( void* field, const char*& begin,
+                          const char* end )
+  {
+    if ( std::size_t( end - begin ) < sizeof( F ) ) return false;
+
+    std::memcpy( field, begin, sizeof( F ) );
+    begin += sizeof( F );
+    return true;
+  }
+
+private:
+  // whether the value converts to an F without wrapping or throwing
+  static bool fits( const Json::Value&, bool ) { return true; }
+  static bool fits( const Json::Value& v, double )
+  {
+    double magnitude = v.asDouble();
+    if ( magnitude < 0 ) magnitude = -magnitude;
+    return magnitude <= double( std::numeric_limits<F>::max() );
+  }
+  static bool fits( const Json::Value& v, Json::Int64 )
+  {
+    return v.isInt64() &&
+           v.asInt64() >= Json::Int64( std::numeric_limits<F>::min() ) &&
+           v.asInt64() <= Json::Int64( std::numeric_limits<F>::max() );
+  }
+  static bool fits( const Json::Value& v, Json::UInt64 )
+  {
+    return v.isUInt64() &&
+           v.asUInt64() <= Json::UInt64( std::numeric_limits<F>::max() );
+  }
+
+  static bool read( const Json::Value& v, bool ) { return v.asBool(); }
+  static double read( const Json::Value& v, double )
+  {
+    return v.asDouble();
+  }
+  static Json::Int64 read( const Json::Value& v, Json::Int64 )
+  {
+    return v.asInt64();
+  }
+  static Json::UInt64 read( const Json::Value& v, Json::UInt64 )
+  {
+    return v.asUInt64();
+  }
+};
+
+template <>
+struct FieldCodecFor<std::string>
+{
+  static const FieldCodec& get();
+};
+
+/**
+ * Describes one data member of a reflected type.
+ **/
+struct Field
+{
+  std::string name;
+  std::size_t offset;
+  const MetaData* metaData;
+  const FieldCodec* codec;
+};
+
+/**
+ * The fields of a reflected type, which drive its generated JSON and
+ * binary serializers.
+ * JSON objects are read in a single pass: jsoncpp keeps members
+ * sorted by name, so they are merged against the fields, which are
+ * sorted the same way once up front, instead of looking each field
+ * up in the object. The binary format is the fields in declaration
+ * order: arithmetic fields as their raw bytes, strings as a 32 bit
+ * length followed by the characters.
+ **/
+class TypeFields
+{
+  std::vector<Field> fields;
+
+  // indices into fields, ordered by name like jsoncpp's members
+  std::vector<std::size_t> byName;
+
+public:
+  /**
+   * Adds a field, names must be unique.
+   **/
+  void add( Field field );
+
+  /**
+   * Returns the fields in declaration order.
+   **/
+  const std::vector<Field>& getFields() const noexcept;
+
+  /**
+   * Returns the field with the name, nullptr if there is none.
+   **/
+  const Field* find( const std::string& name ) const noexcept;
+
+  /**
+   * Writes every field as a member of the JSON object.
+   **/
+  bool serialize( const void* obj, Json::Value& root ) const;
+
+  /**
+   * Reads the fields present in the JSON object, fields which are
+   * missing keep their value.
+   * @return false if root is not an object or a member's value does
+   *         not fit its field.
+   **/
+  bool deserialize( void* obj, const Json::Value& root ) const;
+
+  /**
+   * Appends the fields in the binary format.
+   **/
+  void writeBinary( const void* obj, std::string& out ) const;
+
+  /**
+   * Reads the fields from the binary format.
+   * @param begin Advanced past the bytes which were read.
+   * @return false if the input ended early.
+   **/
+  bool readBinary( void* obj, const char*& begin,
+                   const char* end ) const;
+};
+
+/**
+ * Returns the offset of a data member within T.
+ **/
+template <typename T, typename F>
+std::size_t memberOffset( F T::*member ) noexcept
+{
+  // taken from storage which is never constructed or read
+  typename std::aligned_storage<sizeof( T ), alignof( T )>::type
+    storage;
+  const T* obj = reinterpret_cast<const T*>( &storage );
+
+  return std::size_t(
+    reinterpret_cast<const char*>( &( obj->*member ) ) -
+    reinterpret_cast<const char*>( obj ) );
+}
+
+/**
+ * Collects the fields of T. Types opt in to reflection by declaring,
+ * next to the type so that ADL finds it,
+ *
+ *   void reflect( tetra::meta::FieldList<T>& fields )
+ *   {
+ *     fields.add( "x", &T::x ).add( "y", &T::y );
+ *   }
+ *
+ * which is called once, the first time T's fields are needed. Types
+ * with fields and no hand written serialize/deserialize get JSON
+ * serialization generated from them.
+ **/
+template <typename T>
+class FieldList
+{
+  TypeFields& fields;
+
+  explicit FieldList( TypeFields& fields ) noexcept : fields{fields}
+  { }
+
+public:
+  /**
+   * Registers a data member.
+   * @param name The member's name in JSON.
+   * @param member Pointer to the data member.
+   * - Note: U defers naming T::* so that HasReflection can probe
+   *   FieldList<T> for non-class types.
+   **/
+  template <typename F, typename U = T>
+  FieldList& add( const char* name, F U::*member )
+  {
+    fields.add( {name, memberOffset( member ), &MetaData::get<F>(),
+                 &FieldCodecFor<F>::get()} );
+    return *this;
+  }
+
+  /**
+   * Returns T's fields, built by calling reflect the first time.
+   **/
+  static const TypeFields* getFields()
+  {
+    static const TypeFields typeFields = build();
+    return &typeFields;
+  }
+
+  static bool serialize( const void* obj, Json::Value& root )
+  {
+    return getFields()->serialize( obj, root );
+  }
+
+  static bool deserialize( void* obj, const Json::Value& root )
+  {
+    return getFields()->deserialize( obj, root );
+  }
+
+private:
+  static TypeFields build()
+  {
+    TypeFields typeFields{};
+    FieldList list{typeFields};
+    reflect( list );
+
+    return typeFields;
+  }
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
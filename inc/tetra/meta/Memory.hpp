@@ -0,0 +1,41 @@
+#pragma once
+#ifndef TETRA_META_MEMORY_HPP
+#define TETRA_META_MEMORY_HPP
+
+#include <cstddef>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Allocates freestore memory with the requested alignment, which may
+ * be larger than the alignment that operator new guarantees.
+ * @throws std::bad_alloc if the allocation fails.
+ * @param size The number of bytes to allocate.
+ * @param alignment A power of two.
+ * @return Unmanaged pointer to the memory, release it with
+ *         alignedFree.
+ **/
+void* alignedAllocate( std::size_t size, std::size_t alignment );
+
+/**
+ * Releases memory returned by alignedAllocate, nullptr is ignored.
+ **/
+void alignedFree( void* memory ) noexcept;
+
+/**
+ * Rounds offset up to the next multiple of alignment (a power of
+ * two).
+ **/
+inline std::size_t alignUp( std::size_t offset,
+                            std::size_t alignment ) noexcept
+{
+  return ( offset + alignment - 1 ) & ~( alignment - 1 );
+}
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,116 @@
+#pragma once
+#ifndef TETRA_META_METAARRAY_HPP
+#define TETRA_META_METAARRAY_HPP
+
+#include <tetra/meta/MetaData.hpp>
+
+#include <cstddef>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * A growable array which stores instances of a single type back to
+ * back in one aligned allocation. The type is only known through its
+ * MetaData, which is used to construct, relocate and destroy the
+ * elements.
+ **/
+class MetaArray
+{
+  const MetaData* metaData;
+  char* elements{nullptr};
+  std::size_t count{0};
+  std::size_t allocated{0};
+
+public:
+  /**
+   * Creates an empty array of instances of the described type.
+   **/
+  explicit MetaArray( const MetaData& metaData ) noexcept;
+
+  /**
+   * Destroys the elements and frees the storage.
+   **/
+  ~MetaArray();
+
+  /**
+   * MetaArrays are move only, the moved-from array is left empty.
+   **/
+  MetaArray( const MetaArray& ) = delete;
+  MetaArray& operator=( const MetaArray& ) = delete;
+  MetaArray( MetaArray&& array ) noexcept;
+  MetaArray& operator=( MetaArray&& array ) noexcept;
+
+  /**
+   * Returns the MetaData which describes the elements.
+   **/
+  const MetaData& getMetaData() const noexcept;
+
+  std::size_t size() const noexcept;
+  std::size_t capacity() const noexcept;
+  bool empty() const noexcept;
+
+  /**
+   * Returns the first element, elements are getMetaData().getSize()
+   * bytes apart.
+   **/
+  void* data() const noexcept;
+
+  /**
+   * Returns the element at index, no bounds checking.
+   **/
+  void* at( std::size_t index ) const noexcept
+  {
+    return elements + index * metaData->getSize();
+  }
+
+  /**
+   * Grows the storage to hold at least capacity elements, relocating
+   * the existing elements.
+   **/
+  void reserve( std::size_t capacity );
+
+  /**
+   * Default constructs a new element at the end of the array.
+   * @return The new element.
+   **/
+  void* emplaceBack();
+
+  /**
+   * Relocates an instance from outside the array to the end of the
+   * array, src is left as uninitialized storage.
+   * @return The new element.
+   **/
+  void* relocateBack( void* src );
+
+  /**
+   * Destroys the element at index and relocates the last element into
+   * its place. Does not preserve the order of the elements.
+   **/
+  void swapRemove( std::size_t index ) noexcept;
+
+  /**
+   * Destroys the last element.
+   **/
+  void popBack() noexcept;
+
+  /**
+   * Destroys all elements, keeps the storage.
+   **/
+  void clear() noexcept;
+
+  /**
+   * Reallocates the storage to hold exactly size() elements.
+   **/
+  void shrinkToFit();
+
+private:
+  void reallocate( std::size_t capacity );
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
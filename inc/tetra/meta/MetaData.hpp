@@ -2,10 +2,18 @@
 #ifndef TETRA_META_METADATA_HPP
 #define TETRA_META_METADATA_HPP
 
+#include <tetra/meta/Memory.hpp>
+
 #include <json/json-forwards.h>
 
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
 #include <typeinfo>
+#include <type_traits>
 #include <string>
+#include <utility>
 
 namespace tetra
 {
@@ -18,6 +26,23 @@ struct HasSerializer;
 template <class T>
 struct HasDeserializer;
 
+template <class T>
+struct HasReflection;
+
+template <class T>
+struct HasHash;
+
+template <class T>
+struct HasEquality;
+
+template <class T>
+struct HasLessThan;
+
+template <class T>
+class FieldList;
+
+class TypeFields;
+
 /**
  * Holds function pointers which facilitate the safe construction and
  * destruction of a given class. Instances are unique for given types.
@@ -26,18 +51,54 @@ class MetaData
 {
   using MetaConstructor  = void* ( * )();
   using MetaDestructor   = void ( * )( void* );
-  using MetaCopy         = void ( * )( void*, void* );
+  using MetaCopy         = void ( * )( void*, const void* );
   using MetaSerializer   = bool ( * )( void*, Json::Value& );
-  using MetaDeserializer = bool (*) ( void*, Json::Value& );
+  using MetaDeserializer = bool ( * )( void*, const Json::Value& );
+  using MetaConstructAt  = void ( * )( void* );
+  using MetaDestroyAt    = void ( * )( void* );
+  using MetaRelocate     = void ( * )( void*, void* );
+  using MetaDeallocate   = void ( * )( void* );
+  using MetaHash         = std::size_t ( * )( const void* );
+  using MetaCompare      = bool ( * )( const void*, const void* );
+
+  /**
+   * Describes how instances are laid out in memory and how to manage
+   * their lifetime in storage that the MetaData did not allocate.
+   **/
+  struct Layout
+  {
+    std::size_t     size;
+    std::size_t     alignment;
+    bool            triviallyCopyable;
+    MetaConstructAt constructAt;
+    MetaDestroyAt   destroyAt;
+    MetaRelocate    relocate;
+    MetaDeallocate  deallocate;
+  };
 
+  /**
+   * The optional value operations, each is nullptr when the type does
+   * not support it.
+   **/
+  struct Comparison
+  {
+    MetaHash    hash;
+    MetaCompare equal;
+    MetaCompare less;
+  };
+
+  const std::size_t      typeIndex;
+  const Layout           layout;
+  const Comparison       comparison;
   const bool             supportsSerialization{false};
   const MetaCopy         typeCopy;
   const MetaConstructor  typeConstructor;
   const MetaDestructor   typeDestructor;
   const MetaSerializer   typeSerializer{nullptr};
   const MetaDeserializer typeDeserializer{nullptr};
+  const TypeFields*      typeFields{nullptr};
 
-  template <class T, bool b>
+  template <class T, bool serializer, bool reflected>
   struct MetaDataConstructor;
 
 public:
@@ -53,7 +114,8 @@ public:
   {
     return MetaDataConstructor< T,
              HasSerializer<T>::value &&
-             HasDeserializer<T>::value
+             HasDeserializer<T>::value,
+             HasReflection<T>::value
            >::get();
   }
 
@@ -70,6 +132,20 @@ public:
    **/
   bool operator==( const MetaData& metaData ) const noexcept;
 
+  /**
+   * Returns a small integer which is unique to the type that this
+   * MetaData represents. Indices are handed out densely, starting at
+   * zero, in the order that MetaData instances are first requested.
+   * This makes them suitable for indexing lookup tables.
+   **/
+  std::size_t getTypeIndex() const noexcept;
+
+  /**
+   * Returns the number of MetaData instances created so far, every
+   * type index is less than this.
+   **/
+  static std::size_t getTypeCount() noexcept;
+
   /**
    * Constructs an instance of the class that this MetaData
    * represents.
@@ -84,6 +160,55 @@ public:
    **/
   void destroyInstance( void* obj ) const noexcept;
 
+  /**
+   * Returns sizeof for the type that this MetaData represents.
+   **/
+  std::size_t getSize() const noexcept;
+
+  /**
+   * Returns alignof for the type that this MetaData represents.
+   * Instances made by constructInstance honour it, including
+   * alignments beyond what operator new guarantees.
+   **/
+  std::size_t getAlignment() const noexcept;
+
+  /**
+   * Returns true if the type is trivially copyable, in which case
+   * instances may be copied and relocated with memcpy.
+   **/
+  bool isTriviallyCopyable() const noexcept;
+
+  /**
+   * Default constructs an instance in caller provided storage.
+   * @param memory Uninitialized storage of at least getSize() bytes,
+   *        aligned to getAlignment().
+   **/
+  void constructInstanceAt( void* memory ) const;
+
+  /**
+   * Destroys an instance which was constructed with
+   * constructInstanceAt (or relocated), without freeing its storage.
+   * @param obj The instance to destroy.
+   **/
+  void destroyInstanceAt( void* obj ) const noexcept;
+
+  /**
+   * Moves an instance to new storage: move constructs into dest and
+   * then destroys src, leaving src as uninitialized storage.
+   * @param dest Uninitialized storage, sized and aligned for the type.
+   * @param src The instance to relocate.
+   * @throws Whatever the type's move constructor throws, src is then
+   *         left as it was.
+   **/
+  void relocateInstance( void* dest, void* src ) const;
+
+  /**
+   * Frees the storage of an instance allocated by constructInstance
+   * which has already been destroyed or relocated elsewhere.
+   * @param memory The storage returned by constructInstance.
+   **/
+  void deallocateInstance( void* memory ) const noexcept;
+
   /**
    * Returns true if this type can be serialized/deserialized. If not,
    * then calling serialize/deserialize will likely result in
@@ -92,13 +217,55 @@ public:
    **/
   bool canSerialize() const noexcept;
 
+  /**
+   * Returns the fields registered for the type through a reflect
+   * function (see FieldList), nullptr for types without one.
+   **/
+  const TypeFields* getFields() const noexcept;
+
+  /**
+   * Returns true if the type has a hash function, either a metaHash
+   * found with ADL (see HasHash) or std::hash for arithmetic types
+   * and std::string.
+   **/
+  bool canHash() const noexcept;
+
+  /**
+   * Returns true if the type has a metaEqual function (see
+   * HasEquality), or is an arithmetic type or std::string.
+   **/
+  bool canCompareEqual() const noexcept;
+
+  /**
+   * Returns true if the type has a metaLess function (see
+   * HasLessThan), or is an arithmetic type or std::string.
+   **/
+  bool canCompareLess() const noexcept;
+
+  /**
+   * Hashes the object, check canHash() first.
+   **/
+  std::size_t hashInstance( const void* obj ) const;
+
+  /**
+   * Compares two instances for equality, check canCompareEqual()
+   * first.
+   **/
+  bool equalInstances( const void* lhs, const void* rhs ) const;
+
+  /**
+   * Orders two instances, check canCompareLess() first.
+   **/
+  bool lessInstance( const void* lhs, const void* rhs ) const;
+
   /**
    * Copy's the data in rhs into lhs using the provided copy
    * constructor.
    * @param lhs - The "left hand" side of the copy, gets moodified.
    * @param rhs - The "right hand" side of the copy, not modified.
+   * @throws Whatever the type's copy assignment throws.
    **/
-  void copyInstance( void* lhs, void* rhs ) const noexcept;
+  void copyInstance( void* lhs, const void* rhs ) const;
 
   /**
    * Serializes the object into the Json::Value node.
@@ -116,35 +283,56 @@ public:
    * @param obj The object to deserialize into
    * @param root The Json::Value node to deserialize from.
    **/
-  bool deserializeInstance( void* obj, Json::Value& root ) const;
+  bool deserializeInstance( void* obj, const Json::Value& root ) const;
 
 private:
   MetaData( MetaConstructor constructor, MetaDestructor destructor,
-            MetaCopy copy );
+            MetaCopy copy, const Layout& layout,
+            const Comparison& comparison );
 
   MetaData( MetaConstructor constructor, MetaDestructor destructor,
-            MetaCopy copy, MetaSerializer serializer,
-            MetaDeserializer deserializer );
+            MetaCopy copy, const Layout& layout,
+            const Comparison& comparison, MetaSerializer serializer,
+            MetaDeserializer deserializer,
+            const TypeFields* fields = nullptr );
+
+  // hand written serializers take precedence over reflected fields,
+  // which are still used for the binary format
+  template <class T, bool reflected>
+  struct MetaDataConstructor<T, true, reflected>
+  {
+    static const MetaData& get()
+    {
+      static MetaData metaData(
+        metaConstructor<T>, metaDestructor<T>, metaCopy<T>,
+        metaLayout<T>(), metaComparison<T>(), metaSerialize<T>,
+        metaDeserialize<T>,
+        metaFields<T>( std::integral_constant<bool, reflected>{} ) );
+      return metaData;
+    }
+  };
 
   template <class T>
-  struct MetaDataConstructor<T, true>
+  struct MetaDataConstructor<T, false, true>
   {
     static const MetaData& get()
     {
-      static MetaData metaData( metaConstructor<T>, metaDestructor<T>,
-                                metaCopy<T>, metaSerialize<T>,
-                                metaDeserialize<T> );
+      static MetaData metaData(
+        metaConstructor<T>, metaDestructor<T>, metaCopy<T>,
+        metaLayout<T>(), metaComparison<T>(), reflectedSerialize<T>,
+        reflectedDeserialize<T>, metaFields<T>( std::true_type{} ) );
       return metaData;
     }
   };
 
   template <class T>
-  struct MetaDataConstructor<T, false>
+  struct MetaDataConstructor<T, false, false>
   {
     static const MetaData& get()
     {
       static MetaData metaData( metaConstructor<T>, metaDestructor<T>,
-                                metaCopy<T> );
+                                metaCopy<T>, metaLayout<T>(),
+                                metaComparison<T>() );
       return metaData;
     }
   };
@@ -156,27 +344,215 @@ private:
   }
 
   template <typename T>
-  static bool metaDeserialize( void* obj, Json::Value& root )
+  static bool metaDeserialize( void* obj, const Json::Value& root )
   {
     return deserialize( *reinterpret_cast<T*>( obj ), root );
   }
 
+  template <typename T>
+  static bool reflectedSerialize( void* obj, Json::Value& root )
+  {
+    return FieldList<T>::serialize( obj, root );
+  }
+
+  template <typename T>
+  static bool reflectedDeserialize( void* obj, const Json::Value& root )
+  {
+    return FieldList<T>::deserialize( obj, root );
+  }
+
+  template <typename T>
+  static const TypeFields* metaFields( std::true_type )
+  {
+    return FieldList<T>::getFields();
+  }
+
+  template <typename T>
+  static const TypeFields* metaFields( std::false_type )
+  {
+    return nullptr;
+  }
+
+  // operator new only honours alignments up to that of max_align_t
+  // before C++17, more demanding types get alignedAllocate storage
+  template <typename T>
+  using IsOverAligned = std::integral_constant<
+    bool, ( alignof( T ) > alignof( std::max_align_t ) )>;
+
   template <typename T>
   static void* metaConstructor()
   {
-    return reinterpret_cast<void*>( new T{} );
+    return allocate<T>( IsOverAligned<T>{} );
   }
 
   template <typename T>
   static void metaDestructor( void* obj )
+  {
+    destroy<T>( obj, IsOverAligned<T>{} );
+  }
+
+  template <typename T>
+  static void* allocate( std::false_type )
+  {
+    return reinterpret_cast<void*>( new T{} );
+  }
+
+  template <typename T>
+  static void destroy( void* obj, std::false_type )
   {
     delete reinterpret_cast<T*>( obj );
   }
 
   template <typename T>
-  static void metaCopy( void* lhs, void* rhs )
+  static void destroy( void* obj, std::true_type )
+  {
+    reinterpret_cast<T*>( obj )->~T();
+    alignedFree( obj );
+  }
+
+  template <typename T>
+  static void* allocate( std::true_type )
+  {
+    void* memory = alignedAllocate( sizeof( T ), alignof( T ) );
+    try
+    {
+      return reinterpret_cast<void*>( new ( memory ) T{} );
+    }
+    catch ( ... )
+    {
+      alignedFree( memory );
+      throw;
+    }
+  }
+
+  template <typename T>
+  static void metaCopy( void* lhs, const void* rhs )
+  {
+    *reinterpret_cast<T*>( lhs ) = *reinterpret_cast<const T*>( rhs );
+  }
+
+  template <typename T>
+  static Layout metaLayout()
+  {
+    return {sizeof( T ), alignof( T ),
+            std::is_trivially_copyable<T>::value, metaConstructAt<T>,
+            metaDestroyAt<T>, metaRelocate<T>, metaDeallocate<T>};
+  }
+
+  template <typename T>
+  static Comparison metaComparison()
+  {
+    return {
+      hashEntry<T>( std::integral_constant<bool, HasHash<T>::value>{} ),
+      equalEntry<T>(
+        std::integral_constant<bool, HasEquality<T>::value>{} ),
+      lessEntry<T>(
+        std::integral_constant<bool, HasLessThan<T>::value>{} )};
+  }
+
+  template <typename T>
+  static MetaHash hashEntry( std::true_type )
+  {
+    return erasedHash<T>;
+  }
+
+  template <typename T>
+  static MetaHash hashEntry( std::false_type )
   {
-    *reinterpret_cast<T*>( lhs ) = *reinterpret_cast<T*>( rhs );
+    return nullptr;
+  }
+
+  template <typename T>
+  static MetaCompare equalEntry( std::true_type )
+  {
+    return erasedEqual<T>;
+  }
+
+  template <typename T>
+  static MetaCompare equalEntry( std::false_type )
+  {
+    return nullptr;
+  }
+
+  template <typename T>
+  static MetaCompare lessEntry( std::true_type )
+  {
+    return erasedLess<T>;
+  }
+
+  template <typename T>
+  static MetaCompare lessEntry( std::false_type )
+  {
+    return nullptr;
+  }
+
+  template <typename T>
+  static std::size_t erasedHash( const void* obj )
+  {
+    return HasHash<T>::apply( *reinterpret_cast<const T*>( obj ) );
+  }
+
+  template <typename T>
+  static bool erasedEqual( const void* lhs, const void* rhs )
+  {
+    return HasEquality<T>::apply( *reinterpret_cast<const T*>( lhs ),
+                                  *reinterpret_cast<const T*>( rhs ) );
+  }
+
+  template <typename T>
+  static bool erasedLess( const void* lhs, const void* rhs )
+  {
+    return HasLessThan<T>::apply( *reinterpret_cast<const T*>( lhs ),
+                                  *reinterpret_cast<const T*>( rhs ) );
+  }
+
+  template <typename T>
+  static void metaConstructAt( void* memory )
+  {
+    new ( memory ) T{};
+  }
+
+  template <typename T>
+  static void metaDestroyAt( void* obj )
+  {
+    reinterpret_cast<T*>( obj )->~T();
+  }
+
+  template <typename T>
+  static void metaDeallocate( void* memory )
+  {
+    deallocate( memory, IsOverAligned<T>{} );
+  }
+
+  static void deallocate( void* memory, std::false_type )
+  {
+    // matches the allocation made by new T in allocate
+    ::operator delete( memory );
+  }
+
+  static void deallocate( void* memory, std::true_type )
+  {
+    alignedFree( memory );
+  }
+
+  template <typename T>
+  static void metaRelocate( void* dest, void* src )
+  {
+    relocate<T>( dest, src, std::is_trivially_copyable<T>{} );
+  }
+
+  template <typename T>
+  static void relocate( void* dest, void* src, std::true_type )
+  {
+    std::memcpy( dest, src, sizeof( T ) );
+  }
+
+  template <typename T>
+  static void relocate( void* dest, void* src, std::false_type )
+  {
+    T* obj = reinterpret_cast<T*>( src );
+    new ( dest ) T( std::move( *obj ) );
+    obj->~T();
   }
 };
 
@@ -213,8 +589,9 @@ struct HasDeserializer
 {
   template <class Type>
   static std::true_type hasDeserializer(
-    decltype( deserialize( *reinterpret_cast<Type*>( 0 ),
-                           *reinterpret_cast<Json::Value*>( 0 ) ) ) );
+    decltype( deserialize(
+      *reinterpret_cast<Type*>( 0 ),
+      *reinterpret_cast<const Json::Value*>( 0 ) ) ) );
   template <class Type>
   static std::false_type hasDeserializer( ... );
 
@@ -222,6 +599,170 @@ struct HasDeserializer
     std::true_type, decltype( hasDeserializer<T>( false ) )>::value;
 };
 
+/**
+ * Uses SFINAE to detect the presence of a reflect function with the
+ * following signature: void reflect( FieldList<Type>& fields );
+ * - Note: like serialize, the reflect function should be in the same
+ *   namespace as the type, then it will be found with ADL.
+ **/
+template <class T>
+struct HasReflection
+{
+  template <class Type>
+  static std::true_type hasReflection(
+    decltype( reflect( *reinterpret_cast<FieldList<Type>*>( 0 ) ),
+              false ) );
+  template <class Type>
+  static std::false_type hasReflection( ... );
+
+  constexpr static bool value = std::is_same<
+    std::true_type, decltype( hasReflection<T>( false ) )>::value;
+};
+
+/**
+ * True for the types which are hashed and compared with std::hash
+ * and their built in operators, without a customization.
+ **/
+template <class T>
+struct IsBuiltinComparable
+  : std::integral_constant<bool, std::is_arithmetic<T>::value ||
+                                   std::is_same<T, std::string>::value>
+{ };
+
+/**
+ * Uses SFINAE to detect the presence of a hash function with the
+ * following signature: std::size_t metaHash( const Type& obj );
+ * - Note: the metaHash function should be in the same namespace as
+ *   the type, then it will be found with ADL. Arithmetic types and
+ *   std::string use std::hash instead.
+ **/
+template <class T>
+struct HasHash
+{
+  template <class Type>
+  static std::true_type hasHash(
+    typename std::enable_if<
+      std::is_convertible<
+        decltype( metaHash( *reinterpret_cast<const Type*>( 0 ) ) ),
+        std::size_t>::value,
+      bool>::type );
+  template <class Type>
+  static std::false_type hasHash( ... );
+
+  constexpr static bool hasFunction = std::is_same<
+    std::true_type, decltype( hasHash<T>( false ) )>::value;
+
+  constexpr static bool value =
+    hasFunction || IsBuiltinComparable<T>::value;
+
+  static std::size_t apply( const T& obj )
+  {
+    return apply( obj, std::integral_constant<bool, hasFunction>{} );
+  }
+
+private:
+  static std::size_t apply( const T& obj, std::true_type )
+  {
+    return metaHash( obj );
+  }
+
+  static std::size_t apply( const T& obj, std::false_type )
+  {
+    return std::hash<T>{}( obj );
+  }
+};
+
+/**
+ * Uses SFINAE to detect the presence of an equality function with the
+ * following signature: bool metaEqual( const Type& lhs,
+ * const Type& rhs );
+ * - Note: found with ADL like metaHash. The raw operator== is not
+ *   probed, the std containers declare it for any element type and
+ *   only fail when it is instantiated. Arithmetic types and
+ *   std::string use their built in operator==.
+ **/
+template <class T>
+struct HasEquality
+{
+  template <class Type>
+  static std::true_type hasEquality(
+    typename std::enable_if<
+      std::is_convertible<
+        decltype( metaEqual( *reinterpret_cast<const Type*>( 0 ),
+                             *reinterpret_cast<const Type*>( 0 ) ) ),
+        bool>::value,
+      bool>::type );
+  template <class Type>
+  static std::false_type hasEquality( ... );
+
+  constexpr static bool hasFunction = std::is_same<
+    std::true_type, decltype( hasEquality<T>( false ) )>::value;
+
+  constexpr static bool value =
+    hasFunction || IsBuiltinComparable<T>::value;
+
+  static bool apply( const T& lhs, const T& rhs )
+  {
+    return apply( lhs, rhs,
+                  std::integral_constant<bool, hasFunction>{} );
+  }
+
+private:
+  static bool apply( const T& lhs, const T& rhs, std::true_type )
+  {
+    return metaEqual( lhs, rhs );
+  }
+
+  static bool apply( const T& lhs, const T& rhs, std::false_type )
+  {
+    return lhs == rhs;
+  }
+};
+
+/**
+ * Uses SFINAE to detect the presence of an ordering function with the
+ * following signature: bool metaLess( const Type& lhs,
+ * const Type& rhs );
+ * - Note: found with ADL like metaEqual, for the same reasons.
+ **/
+template <class T>
+struct HasLessThan
+{
+  template <class Type>
+  static std::true_type hasLessThan(
+    typename std::enable_if<
+      std::is_convertible<
+        decltype( metaLess( *reinterpret_cast<const Type*>( 0 ),
+                            *reinterpret_cast<const Type*>( 0 ) ) ),
+        bool>::value,
+      bool>::type );
+  template <class Type>
+  static std::false_type hasLessThan( ... );
+
+  constexpr static bool hasFunction = std::is_same<
+    std::true_type, decltype( hasLessThan<T>( false ) )>::value;
+
+  constexpr static bool value =
+    hasFunction || IsBuiltinComparable<T>::value;
+
+  static bool apply( const T& lhs, const T& rhs )
+  {
+    return apply( lhs, rhs,
+                  std::integral_constant<bool, hasFunction>{} );
+  }
+
+private:
+  static bool apply( const T& lhs, const T& rhs, std::true_type )
+  {
+    return metaLess( lhs, rhs );
+  }
+
+  static bool apply( const T& lhs, const T& rhs, std::false_type )
+  {
+    return lhs < rhs;
+  }
+};
+
 } /* namespace meta */
 } /* namespace tetra */
 
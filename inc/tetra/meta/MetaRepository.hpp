@@ -4,10 +4,11 @@
 
 #include <tetra/meta/Variant.hpp>
 
-#include <json/json-forwards.h>
+#include <json/json.h>
 
 #include <stdexcept>
 #include <map>
+#include <vector>
 
 namespace tetra
 {
@@ -37,6 +38,16 @@ class MetaRepository
   std::map<std::string, const MetaData*> nameToMetaMap;
   std::map<const MetaData*, std::string> metaToNameMap;
 
+  /**
+   * Remembers the most recently resolved type, so that runs of
+   * objects with the same type skip the map lookups.
+   **/
+  struct TypeCache
+  {
+    const MetaData* metaData{nullptr};
+    const std::string* typeName{nullptr};
+  };
+
 public:
   /**
    * Adds MetaData for the basic primitive types: int, float, double,
@@ -77,6 +88,26 @@ public:
    **/
   const std::string& getTypeName( const MetaData& metaData ) const;
 
+  /**
+   * Returns MetaData for the type which was registered with the
+   * given typeName, without throwing when it is missing.
+   * @param typeName The name of the type to look up.
+   * @return Pointer to the MetaData for the type, or nullptr if the
+   *         type was not registered.
+   **/
+  const MetaData* findMetaData( const std::string& typeName ) const
+    noexcept;
+
+  /**
+   * Returns the name for the registered type, without throwing when
+   * it is missing.
+   * @param metaData MetaData for the type.
+   * @return Pointer to the typename associated with the metaData, or
+   *         nullptr if the type was not registered.
+   **/
+  const std::string* findTypeName( const MetaData& metaData ) const
+    noexcept;
+
   /**
    * Uses the registered MetaData to create an instance of the
    * Variant.
@@ -109,9 +140,117 @@ public:
    * @param root The Json::Value to deserialize from.
    * @return A variant containing the deserialized object.
    **/
-  Variant deserialize( Json::Value& root ) const;
+  Variant deserialize( const Json::Value& root ) const;
+
+  /**
+   * Deserializes the object described by the Json::Value into an
+   * existing Variant. If the Variant already holds the described type
+   * then its payload is deserialized in place and no allocation
+   * takes place, otherwise the Variant is replaced by a new instance
+   * of the described type.
+   * Note: fields which the in-place deserializer does not write keep
+   * their previous values.
+   * @throws TypeNotRegistered if the described type is not
+   *         registered.
+   * @param target The Variant to deserialize into.
+   * @param root The Json::Value to deserialize from.
+   **/
+  void deserializeInto( Variant& target,
+                        const Json::Value& root ) const;
+
+  /**
+   * Deserializes the object described by the Json::Value, reporting
+   * failures by return value instead of throwing.
+   * @param root The Json::Value to deserialize from.
+   * @param result Receives the deserialized object on success, left
+   *        untouched on failure.
+   * @return false if root is not an object with a string "type",
+   *         the described type is not registered, or its "object"
+   *         is not an object or fails to deserialize.
+   **/
+  bool tryDeserialize( const Json::Value& root,
+                       Variant& result ) const;
+
+  /**
+   * Serializes each Variant in [first, last) and appends the results
+   * to the array node. The type name lookup is skipped for runs of
+   * Variants of the same type.
+   * @throws TypeNotRegistered if a Variant contains an unregistered
+   *         type.
+   * @templateParam InputIt An input iterator over Variants.
+   * @param first The first Variant to serialize.
+   * @param last One past the last Variant to serialize.
+   * @param array The Json::Value array to append to.
+   **/
+  template <typename InputIt>
+  void serializeMany( InputIt first, InputIt last,
+                      Json::Value& array ) const
+  {
+    if ( array.isNull() ) array = Json::Value{Json::arrayValue};
+
+    Json::ArrayIndex index = array.size();
+    TypeCache cache{};
+    for ( ; first != last; ++first )
+      serialize( *first, array[index++], cache );
+  }
+
+  /**
+   * Deserializes each element of the array node and writes the
+   * resulting Variants to out. The type lookup is skipped for runs
+   * of elements of the same type.
+   * @throws TypeNotRegistered if an element has an unregistered type.
+   * @templateParam OutputIt An output iterator accepting Variants.
+   * @param array A Json::Value array of serialized objects.
+   * @param out The iterator to write the Variants to.
+   * @return The output iterator, one past the last Variant written.
+   **/
+  template <typename OutputIt>
+  OutputIt deserializeMany( const Json::Value& array,
+                            OutputIt out ) const
+  {
+    TypeCache cache{};
+    for ( auto iter = array.begin(); iter != array.end(); ++iter )
+      *out++ = deserialize( *iter, cache );
+
+    return out;
+  }
+
+  /**
+   * Deserializes each element of the array node into a vector which
+   * is allocated once up-front.
+   * @see deserializeMany( const Json::Value&, OutputIt )
+   **/
+  std::vector<Variant> deserializeMany( const Json::Value& array ) const;
 
 private:
+  /**
+   * Serializes the Variant, using the cache to look up its name.
+   **/
+  void serialize( const Variant& obj, Json::Value& root,
+                  TypeCache& cache ) const;
+
+  /**
+   * Deserializes the Variant, using the cache to look up its type.
+   **/
+  Variant deserialize( const Json::Value& root,
+                       TypeCache& cache ) const;
+
+  /**
+   * Returns the MetaData for the type named by the root's "type"
+   * node. Only searches the repository if the name differs from the
+   * cached name, in which case the cache is updated.
+   * @throws TypeNotRegistered if the type is not registered.
+   **/
+  const MetaData& resolveType( const Json::Value& root,
+                               TypeCache& cache ) const;
+
+  /**
+   * Same as resolveType, but returns nullptr if the type is not
+   * registered.
+   **/
+  const MetaData* findType( const Json::Value& root,
+                            TypeCache& cache ) const;
+
   /**
    * Adds a new type to the MetaRepository, does nothing if T is
    * already registered.
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef TETRA_META_PARALLELFOREACH_HPP
+#define TETRA_META_PARALLELFOREACH_HPP
+
+#include <tetra/meta/ComponentStore.hpp>
+#include <tetra/meta/TaskScheduler.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Returns a grain size, in elements, for splitting arrays of
+ * elementSize byte elements: a whole number of cache lines, and
+ * roughly targetBytes long.
+ **/
+inline std::size_t cacheFriendlyGrain( std::size_t elementSize,
+                                       std::size_t targetBytes = 16384 )
+{
+  const std::size_t cacheLine = 64;
+
+  // the smallest element count which spans whole cache lines
+  std::size_t lineElements = 1;
+  while ( ( lineElements * elementSize ) % cacheLine != 0 &&
+          lineElements < cacheLine )
+    ++lineElements;
+
+  std::size_t lines =
+    std::max<std::size_t>( 1, targetBytes / ( lineElements * elementSize ) );
+  return lines * lineElements;
+}
+
+/**
+ * Calls f( entity, component ) for every component of type T in the
+ * store, in parallel on the scheduler's threads. The contiguous
+ * component array is split into cache line aligned ranges, so no two
+ * threads write to the same cache line.
+ * The callable must not add or remove components of type T.
+ * @param grain Elements per range, 0 picks a cache friendly size.
+ **/
+template <typename T, typename F>
+void parallelForEach( TaskScheduler& scheduler,
+                      const ComponentStore& store, F f,
+                      std::size_t grain = 0 )
+{
+  ComponentView<T> view = store.components<T>();
+  if ( grain == 0 ) grain = cacheFriendlyGrain( sizeof( T ) );
+
+  scheduler.parallelFor(
+    0, view.size(), grain,
+    [&view, &f]( std::size_t first, std::size_t last ) {
+      for ( std::size_t i = first; i < last; ++i )
+        f( view.entity( i ), view[i] );
+    } );
+}
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
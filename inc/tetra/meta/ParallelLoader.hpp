@@ -0,0 +1,104 @@
+#pragma once
+#ifndef TETRA_META_PARALLELLOADER_HPP
+#define TETRA_META_PARALLELLOADER_HPP
+
+#include <tetra/meta/MetaRepository.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Thrown by the ParallelLoader when a line of the input is not valid
+ * JSON.
+ **/
+class ParseException : public std::runtime_error
+{
+  const std::size_t lineNumber;
+
+public:
+  ParseException( std::size_t lineNumber, const std::string& errors );
+
+  /**
+   * Returns the 1-based line number of the line which failed to
+   * parse.
+   **/
+  std::size_t getLineNumber() const noexcept;
+};
+
+/**
+ * Deserializes newline delimited JSON (one MetaRepository serialized
+ * object per line) using a pool of worker threads.
+ * The input is split into chunks at line boundaries, and each worker
+ * parses and constructs the Variants for the chunks it claims.
+ **/
+class ParallelLoader
+{
+  const MetaRepository& repository;
+  const unsigned threadCount;
+
+public:
+  /**
+   * Selects the order in which load returns the deserialized
+   * Variants.
+   * InputOrder - The Variants appear in the order of the input lines.
+   * Unordered  - The Variants of each chunk are appended as soon as
+   *              the chunk is finished, lines within a chunk keep
+   *              their relative order.
+   **/
+  enum class Ordering
+  {
+    InputOrder,
+    Unordered
+  };
+
+  /**
+   * Creates a loader which deserializes with the given repository.
+   * The repository must outlive the loader and must not be modified
+   * while a load is in progress.
+   * @param repository The types which may appear in the input.
+   * @param threadCount The number of threads to deserialize with,
+   *        values less than 1 are treated as 1.
+   **/
+  ParallelLoader( const MetaRepository& repository,
+                  unsigned threadCount );
+
+  /**
+   * Deserializes every non-empty line of the input.
+   * @throws ParseException if a line is not valid JSON.
+   * @throws TypeNotRegisteredException if a line names an
+   *         unregistered type.
+   * @throws std::system_error if a worker thread can not be started,
+   *         after the started ones have been joined.
+   * @param ndjson The newline delimited JSON input.
+   * @param ordering The order to return the Variants in.
+   * @return One Variant for each non-empty line of the input.
+   **/
+  std::vector<Variant>
+  load( const std::string& ndjson,
+        Ordering ordering = Ordering::InputOrder ) const;
+
+  /**
+   * Deserializes every non-empty line in [begin, end).
+   * @see load( const std::string&, Ordering )
+   **/
+  std::vector<Variant>
+  load( const char* begin, const char* end,
+        Ordering ordering = Ordering::InputOrder ) const;
+
+  /**
+   * Returns the number of threads used by load.
+   **/
+  unsigned getThreadCount() const noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
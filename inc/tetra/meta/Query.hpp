@@ -0,0 +1,87 @@
+#pragma once
+#ifndef TETRA_META_QUERY_HPP
+#define TETRA_META_QUERY_HPP
+
+#include <tetra/meta/Archetype.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+class ArchetypeStore;
+
+/**
+ * A cached query for the entities of an ArchetypeStore which have a
+ * set of component types. The query keeps the list of archetypes
+ * which contain all of its types. The store appends to that list
+ * when it creates a matching archetype, so evaluating the query never
+ * re-examines the archetypes it already knows about. Entities enter
+ * and leave the matched archetypes as components are added and
+ * removed, without the query being involved at all.
+ * Queries are created and owned by ArchetypeStore::query.
+ **/
+class Query
+{
+  friend class ArchetypeStore;
+
+  std::vector<const MetaData*> types; // sorted by type index
+  std::vector<const Archetype*> archetypes;
+
+public:
+  /**
+   * Creates a query for entities having all of the types, types
+   * listed more than once count once.
+   **/
+  explicit Query( std::vector<const MetaData*> types );
+
+  Query( const Query& ) = delete;
+  Query& operator=( const Query& ) = delete;
+
+  /**
+   * Returns the required component types, sorted by type index.
+   **/
+  const std::vector<const MetaData*>& getTypes() const noexcept;
+
+  /**
+   * Returns the archetypes which contain all of the required types.
+   **/
+  const std::vector<const Archetype*>& getArchetypes() const noexcept;
+
+  /**
+   * Returns true if the archetype contains all of the required types.
+   **/
+  bool matches( const Archetype& archetype ) const noexcept;
+
+  /**
+   * Returns the number of entities currently matching the query.
+   **/
+  std::size_t size() const noexcept;
+
+  /**
+   * Calls f( entity, Ts&... ) for every matching entity. The types
+   * Ts should be a subset of the query's types.
+   * The callable must not add or remove components.
+   **/
+  template <typename... Ts, typename F>
+  void forEach( F f ) const
+  {
+    for ( const Archetype* archetype : archetypes )
+      archetype->forEach<Ts...>( f );
+  }
+
+private:
+  /**
+   * Adds the archetype to the matches if it contains all of the
+   * required types.
+   **/
+  void consider( const Archetype& archetype );
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,147 @@
+#pragma once
+#ifndef TETRA_META_SERIALIZATIONCACHE_HPP
+#define TETRA_META_SERIALIZATIONCACHE_HPP
+
+#include <tetra/meta/MetaRepository.hpp>
+#include <tetra/meta/Variant.hpp>
+
+#include <json/json.h>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Memoizes the serialized forms of Variants which are snapshotted
+ * repeatedly. A Variant's cached JSON node, JSON text and binary
+ * bytes are reused for as long as it stays clean (see
+ * Variant::isDirty), so only the Variants which changed since the
+ * last snapshot run their serializers again.
+ * Entries are keyed by the Variant's address and cleared when a
+ * Variant is found dirty, serializing it marks it clean. Call
+ * finishSnapshot after each snapshot to drop the entries of Variants
+ * which were not serialized in it, such as destroyed or moved-from
+ * ones.
+ * - Note: the clean flag is shared, so a Variant should only be
+ *   snapshotted through one cache.
+ **/
+class SerializationCache
+{
+  struct Entry
+  {
+    const MetaData* metaData{nullptr};
+    const void* payload{nullptr};
+    Json::Value node{};
+    std::string text{};
+    std::string binary{};
+    bool hasNode{false};
+    bool hasText{false};
+    bool hasBinary{false};
+    std::size_t snapshot{0};  // the last snapshot it was used in
+  };
+
+  const MetaRepository* repository;
+  std::unordered_map<const Variant*, Entry> entries;
+  std::size_t hits{0};
+  std::size_t misses{0};
+  std::size_t snapshot{0};
+
+public:
+  /**
+   * @param repository Names the types of the serialized Variants,
+   *        must outlive the cache.
+   **/
+  explicit SerializationCache( const MetaRepository& repository );
+
+  /**
+   * Returns the node which MetaRepository::serialize writes for the
+   * Variant.
+   * @throws TypeNotRegistered if the Variant contains an unregistered
+   *         type.
+   * @return Reference to the cached node, valid until the Variant is
+   *         serialized through the cache again or forgotten.
+   **/
+  const Json::Value& serialize( Variant& variant );
+
+  /**
+   * Returns the node from serialize written by Json::FastWriter.
+   * @throws TypeNotRegistered if the Variant contains an unregistered
+   *         type.
+   **/
+  const std::string& serializeText( Variant& variant );
+
+  /**
+   * Appends the bytes which Variant::writeBinary produces.
+   * @return false if the Variant has no binary format.
+   **/
+  bool writeBinary( Variant& variant, std::string& out );
+
+  /**
+   * Appends the node of each Variant in [first, last) to the array
+   * node, like MetaRepository::serializeMany.
+   * @templateParam InputIt An input iterator over mutable Variants.
+   **/
+  template <typename InputIt>
+  void serializeMany( InputIt first, InputIt last,
+                      Json::Value& array )
+  {
+    if ( array.isNull() ) array = Json::Value{Json::arrayValue};
+
+    for ( ; first != last; ++first ) array.append( serialize( *first ) );
+  }
+
+  /**
+   * Ends the current snapshot, dropping the entries of Variants which
+   * were not serialized through the cache since the previous call.
+   * @return The number of entries dropped.
+   **/
+  std::size_t finishSnapshot();
+
+  /**
+   * Drops the entry of a Variant which is about to be destroyed.
+   **/
+  void forget( const Variant& variant ) noexcept;
+
+  /**
+   * Drops every entry.
+   **/
+  void clear() noexcept;
+
+  /**
+   * Returns the number of Variants with an entry.
+   **/
+  std::size_t size() const noexcept;
+
+  /**
+   * Returns how many requests were answered from an entry.
+   **/
+  std::size_t getHitCount() const noexcept;
+
+  /**
+   * Returns how many requests ran a serializer.
+   **/
+  std::size_t getMissCount() const noexcept;
+
+private:
+  /**
+   * Returns the Variant's entry, emptied if the Variant is dirty or
+   * holds another payload than the entry was made from. The Variant
+   * is marked clean.
+   **/
+  Entry& lookup( Variant& variant );
+
+  /**
+   * Serializes the Variant into the entry's node.
+   **/
+  void makeNode( const Variant& variant, Entry& entry ) const;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
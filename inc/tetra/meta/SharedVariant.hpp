@@ -0,0 +1,166 @@
+#pragma once
+#ifndef TETRA_META_SHAREDVARIANT_HPP
+#define TETRA_META_SHAREDVARIANT_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Reference counted handle to an immutable Variant payload, for
+ * handing one message to many readers.
+ * Copying a SharedVariant only increments an atomic reference count,
+ * however large the payload is. Mutable access first gives the handle
+ * a private copy of the payload (through Variant::copy) if any other
+ * handle shares it, so the other handles never see the change. If
+ * that copy throws, the handle keeps sharing the payload.
+ * Handles may be copied and released from different threads, a
+ * single handle must not be used by two threads at once.
+ **/
+class SharedVariant
+{
+  struct Control
+  {
+    std::atomic<std::size_t> references;
+    Variant variant;
+  };
+
+  Control* control{nullptr};
+
+public:
+  /**
+   * Creates an empty handle.
+   **/
+  SharedVariant() = default;
+
+  /**
+   * Takes ownership of the Variant's payload.
+   * @param variant Left empty.
+   **/
+  explicit SharedVariant( Variant&& variant );
+
+  /**
+   * Creates a SharedVariant holding a copy of the object.
+   **/
+  template <typename T>
+  static SharedVariant create( T&& toStore )
+  {
+    return SharedVariant{Variant::create( std::forward<T>( toStore ) )};
+  }
+
+  ~SharedVariant();
+
+  /**
+   * Copies share the payload.
+   **/
+  SharedVariant( const SharedVariant& shared ) noexcept;
+  SharedVariant& operator=( const SharedVariant& shared ) noexcept;
+
+  /**
+   * The handle that is left behind is empty.
+   **/
+  SharedVariant( SharedVariant&& shared ) noexcept;
+  SharedVariant& operator=( SharedVariant&& shared ) noexcept;
+
+  /**
+   * Returns true if this handle holds no payload.
+   **/
+  bool isEmpty() const noexcept;
+
+  /**
+   * Returns the number of handles sharing the payload, 0 for empty
+   * handles.
+   **/
+  std::size_t getUseCount() const noexcept;
+
+  /**
+   * Returns true if this handle holds an instance of the type that
+   * the MetaData describes.
+   **/
+  bool holds( const MetaData& metaData ) const noexcept;
+
+  /**
+   * Returns the MetaData of the shared payload, nullptr for empty
+   * handles.
+   **/
+  const MetaData* getMetaData() const noexcept;
+
+  /**
+   * Returns the read-only shared payload, nullptr for empty handles.
+   **/
+  const void* getConstPayload() const noexcept;
+
+  /**
+   * Returns a reference to the shared payload.
+   * @throws TypeCastException if the type requested is incompatable
+   *         with the type of the payload.
+   **/
+  template <typename T>
+  const T& getObject() const
+  {
+    const T* obj = tryGetObject<T>();
+    if ( obj == nullptr )
+    {
+      throw TypeCastException{};
+    }
+
+    return *obj;
+  }
+
+  /**
+   * Returns a pointer to the shared payload, or nullptr if the type
+   * requested is incompatable with the type of the payload.
+   **/
+  template <typename T>
+  const T* tryGetObject() const noexcept
+  {
+    return holds( MetaData::get<T>() )
+             ? reinterpret_cast<const T*>( getConstPayload() )
+             : nullptr;
+  }
+
+  /**
+   * Returns the Variant for modification, copying the payload first
+   * if it is shared with other handles.
+   * @throws TypeCastException if the handle is empty.
+   **/
+  Variant& getMutableVariant();
+
+  /**
+   * Returns a reference to the payload for modification, copying the
+   * payload first if it is shared with other handles.
+   * @throws TypeCastException if the type requested is incompatable
+   *         with the type of the payload.
+   **/
+  template <typename T>
+  T& getMutableObject()
+  {
+    if ( !holds( MetaData::get<T>() ) )
+    {
+      throw TypeCastException{};
+    }
+
+    return getMutableVariant().getObject<T>();
+  }
+
+  /**
+   * Empties the handle and returns its payload as a Variant, which
+   * is moved out if no other handle shares it and copied otherwise.
+   **/
+  Variant release();
+
+private:
+  void unshare();
+  void decrement() noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,103 @@
+#pragma once
+#ifndef TETRA_META_SYSTEMSCHEDULE_HPP
+#define TETRA_META_SYSTEMSCHEDULE_HPP
+
+#include <tetra/meta/MetaData.hpp>
+#include <tetra/meta/TaskScheduler.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Declares which component types a system reads and which it writes.
+ **/
+class Access
+{
+  std::vector<const MetaData*> reads;
+  std::vector<const MetaData*> writes;
+
+public:
+  template <typename... Ts>
+  Access& read()
+  {
+    reads.insert( reads.end(), {&MetaData::get<Ts>()...} );
+    return *this;
+  }
+
+  template <typename... Ts>
+  Access& write()
+  {
+    writes.insert( writes.end(), {&MetaData::get<Ts>()...} );
+    return *this;
+  }
+
+  /**
+   * Returns true if the two systems may not run at the same time:
+   * one writes a type which the other reads or writes.
+   **/
+  bool conflictsWith( const Access& access ) const noexcept;
+};
+
+/**
+ * Runs systems, functions which work on component storage, in the
+ * order they were added except that systems whose declared accesses
+ * do not conflict run in parallel.
+ * Each system is put into the first phase after every earlier system
+ * it conflicts with, phases run one after another and the systems of
+ * a phase run in parallel.
+ **/
+class SystemSchedule
+{
+public:
+  using System = std::function<void( TaskScheduler& )>;
+
+private:
+  struct Entry
+  {
+    std::string name;
+    Access access;
+    System system;
+  };
+
+  std::vector<Entry> entries;
+  std::vector<std::vector<std::size_t>> phases;
+
+public:
+  /**
+   * Adds a system to the end of the schedule.
+   * @param name Describes the system.
+   * @param access The component types the system reads and writes.
+   * @param system Called with the scheduler, so that it can use
+   *        parallelForEach itself.
+   **/
+  void add( std::string name, Access access, System system );
+
+  /**
+   * Returns the number of phases the systems were split into.
+   **/
+  std::size_t getPhaseCount() const noexcept;
+
+  /**
+   * Returns the names of the systems in the phase.
+   **/
+  std::vector<std::string> getPhase( std::size_t phase ) const;
+
+  /**
+   * Runs every system once.
+   * @throws The first exception thrown by a system of a phase, the
+   *         remaining phases are not run.
+   **/
+  void run( TaskScheduler& scheduler ) const;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef TETRA_META_TASKSCHEDULER_HPP
+#define TETRA_META_TASKSCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * A pool of worker threads which share work by stealing.
+ * Each thread owns a deque of jobs. A thread takes new work from the
+ * back of its own deque and, when that is empty, steals from the
+ * front of another thread's deque. Ranges are split in halves, so
+ * the oldest job in a deque is the largest, and thieves take big
+ * pieces of work while owners keep working on their recent, cache-hot
+ * pieces.
+ * Threads which wait for work to finish execute jobs while waiting,
+ * so tasks may start and wait for nested parallel work.
+ **/
+class TaskScheduler
+{
+public:
+  using RangeBody = std::function<void( std::size_t, std::size_t )>;
+  using Task = std::function<void()>;
+
+private:
+  struct Batch
+  {
+    std::atomic<std::size_t> pending{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+  };
+
+  struct Job
+  {
+    const RangeBody* body;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t grain;
+    Batch* batch;
+  };
+
+  struct Worker
+  {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  // slot 0 belongs to threads which are not workers of this scheduler
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::vector<std::thread> threads;
+
+  std::atomic<std::size_t> queuedJobs{0};
+  std::mutex sleepMutex;
+  std::condition_variable wakeUp;
+  bool stopping{false};
+
+public:
+  /**
+   * Starts threadCount - 1 worker threads, the thread waiting for
+   * work to finish is the last one.
+   * @param threadCount The number of threads to run jobs on, values
+   *        less than 1 are treated as 1.
+   * @throws std::system_error if a worker thread can not be started,
+   *         after the started ones have been joined.
+   **/
+  explicit TaskScheduler( unsigned threadCount );
+
+  /**
+   * Stops and joins the worker threads. No work may be in progress.
+   **/
+  ~TaskScheduler();
+
+  TaskScheduler( const TaskScheduler& ) = delete;
+  TaskScheduler& operator=( const TaskScheduler& ) = delete;
+
+  /**
+   * Returns the number of threads which run jobs, including the
+   * waiting thread.
+   **/
+  unsigned getThreadCount() const noexcept;
+
+  /**
+   * Calls body( first, last ) for disjoint sub-ranges covering
+   * [begin, end), in parallel, and waits for all of them.
+   * The range is split in halves until the pieces are at most grain
+   * elements long, and split points are always a multiple of grain
+   * away from begin.
+   * @throws The first exception thrown by body, after all sub-ranges
+   *         have finished.
+   **/
+  void parallelFor( std::size_t begin, std::size_t end,
+                    std::size_t grain, const RangeBody& body );
+
+  /**
+   * Runs the tasks in parallel and waits for all of them.
+   * @throws The first exception thrown by a task, after all tasks
+   *         have finished.
+   **/
+  void run( const std::vector<Task>& tasks );
+
+private:
+  std::size_t currentSlot() const noexcept;
+  void push( std::size_t slot, const Job& job );
+  bool tryRunOne( std::size_t slot );
+  void execute( std::size_t slot, Job job );
+  void wait( std::size_t slot, Batch& batch );
+  void workerLoop( std::size_t slot );
+  void stop() noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
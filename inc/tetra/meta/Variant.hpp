@@ -6,7 +6,11 @@
 
 #include <json/json-forwards.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <stdexcept>
+#include <string>
 
 namespace tetra
 {
@@ -24,12 +28,34 @@ public:
   { }
 };
 
+/**
+ * Thrown when a Variant is hashed or compared but the type of its
+ * payload does not support the operation.
+ **/
+class UnsupportedOperationException : public std::runtime_error
+{
+public:
+  inline UnsupportedOperationException()
+    : std::runtime_error{"Type does not support the operation!"}
+  { }
+};
+
 /**
  * Uses MetaData to safely hold a freestore allocated instance
  * of the class that the MetaData describes.
  **/
 class Variant
 {
+  friend class VariantArena;
+
+  // set in pObj when the payload lives in a VariantArena, which owns
+  // the storage, rather than in its own freestore allocation
+  static const std::uintptr_t arenaTag = 1;
+
+  // set in pObj while the payload may differ from what was last
+  // serialized, see isDirty
+  static const std::uintptr_t dirtyTag = 2;
+
   const MetaData* metaData{nullptr};
   void* pObj{nullptr};
 
@@ -85,17 +111,62 @@ public:
   /**
    * Copies the payload and type of the provided variant.
    * @param variant - The variant to copy from.
+   * @throws Whatever constructing or copying the payload throws, the
+   *         Variant is left unchanged.
    **/
-  void copy( const Variant& variant ) noexcept;
+  void copy( const Variant& variant );
 
   /**
    * Returns the MetaData which describes this Variant's payload.
    **/
   const MetaData& getMetaData() const noexcept;
 
+  /**
+   * Returns true if this Variant holds no payload, which is the case
+   * for default constructed and moved-from Variants.
+   **/
+  bool isEmpty() const noexcept;
+
+  /**
+   * Returns true if this Variant holds an instance of the type that
+   * the MetaData describes. Always false for empty Variants.
+   **/
+  bool holds( const MetaData& metaData ) const noexcept;
+
+  /**
+   * Hashes the payload, mixed with its type so equal values of
+   * different types rarely collide. Empty Variants hash to 0.
+   * @throws UnsupportedOperationException if the type has no hash.
+   **/
+  std::size_t hash() const;
+
+  /**
+   * True if both are empty, or both hold the same type and the
+   * payloads compare equal. Variants of different types are never
+   * equal.
+   * @throws UnsupportedOperationException if the payloads are of the
+   *         same type, which can not be compared (see HasEquality).
+   **/
+  bool operator==( const Variant& variant ) const;
+
+  bool operator!=( const Variant& variant ) const
+  {
+    return !( *this == variant );
+  }
+
+  /**
+   * Orders empty Variants first, then by type index, then by value
+   * for payloads of the same type.
+   * @throws UnsupportedOperationException if the payloads are of the
+   *         same type, which can not be ordered (see HasLessThan).
+   **/
+  bool operator<( const Variant& variant ) const;
+
   /**
    * Safely casts the Variant's payload to the type requested
-   * and returns a reference to it.
+   * and returns a reference to it. The payload may be written
+   * through the reference, so the Variant is marked dirty, use
+   * getConstObject for reads.
    * @throws TypeCastException if the type requested is incompatable
    *         with the type of the Variant's payload.
    * @templateParam T The type to cast the payload to.
@@ -103,14 +174,177 @@ public:
    *         type
    **/
   template <typename T>
-  T& getObject() const throw( TypeCastException )
+  T& getObject()
   {
-    if ( metaData != &MetaData::get<T>() )
+    T* obj = tryGetObject<T>();
+    if ( obj == nullptr )
+    {
+      throw TypeCastException{};
+    }
+
+    return *obj;
+  }
+
+  /**
+   * Same as getObject, but does not mark the Variant dirty, so that
+   * const Variants may be read by several threads. Writes through
+   * the reference are not tracked, call markDirty after them.
+   * @throws TypeCastException if the type requested is incompatable
+   *         with the type of the Variant's payload.
+   **/
+  template <typename T>
+  T& getObject() const
+  {
+    T* obj = tryGetObject<T>();
+    if ( obj == nullptr )
+    {
+      throw TypeCastException{};
+    }
+
+    return *obj;
+  }
+
+  /**
+   * Same as getObject, for code which wants writes to stand out.
+   * @throws TypeCastException if the type requested is incompatable
+   *         with the type of the Variant's payload.
+   **/
+  template <typename T>
+  T& getMutableObject()
+  {
+    return getObject<T>();
+  }
+
+  /**
+   * Same as getObject, but read-only, so the Variant stays clean.
+   * @throws TypeCastException if the type requested is incompatable
+   *         with the type of the Variant's payload.
+   **/
+  template <typename T>
+  const T& getConstObject() const
+  {
+    const T* obj = tryGetConstObject<T>();
+    if ( obj == nullptr )
     {
       throw TypeCastException{};
     }
 
-    return *reinterpret_cast<T*>( pObj );
+    return *obj;
+  }
+
+  /**
+   * Safely casts the Variant's payload to the type requested without
+   * throwing on a mismatch.
+   * @templateParam T The type to cast the payload to.
+   * Marks the Variant dirty when the pointer is returned.
+   * @return Pointer to the Variant's payload, or nullptr if the type
+   *         requested is incompatable with the type of the payload.
+   **/
+  template <typename T>
+  T* tryGetObject() noexcept
+  {
+    if ( metaData != &MetaData::get<T>() )
+    {
+      return nullptr;
+    }
+
+    touch();
+    return reinterpret_cast<T*>( payload() );
+  }
+
+  /**
+   * Same as tryGetObject, but does not mark the Variant dirty.
+   **/
+  template <typename T>
+  T* tryGetObject() const noexcept
+  {
+    if ( metaData != &MetaData::get<T>() )
+    {
+      return nullptr;
+    }
+
+    return reinterpret_cast<T*>( payload() );
+  }
+
+  /**
+   * Same as tryGetObject, but read-only, so the Variant stays clean.
+   **/
+  template <typename T>
+  const T* tryGetConstObject() const noexcept
+  {
+    if ( metaData != &MetaData::get<T>() )
+    {
+      return nullptr;
+    }
+
+    return reinterpret_cast<const T*>( payload() );
+  }
+
+  /**
+   * Returns the unmanaged pointer to the payload, nullptr for empty
+   * Variants, and marks the Variant dirty. Prefer getObject, this is
+   * meant for code which has already checked the payload type
+   * through the MetaData.
+   **/
+  void* getPayload() noexcept
+  {
+    touch();
+    return payload();
+  }
+
+  /**
+   * Same as getPayload, but does not mark the Variant dirty.
+   **/
+  void* getPayload() const noexcept
+  {
+    return payload();
+  }
+
+  /**
+   * Same as getPayload, but read-only, so the Variant stays clean.
+   **/
+  const void* getConstPayload() const noexcept
+  {
+    return payload();
+  }
+
+  /**
+   * Returns true if the payload was relocated into a VariantArena.
+   **/
+  bool isInArena() const noexcept
+  {
+    return ( reinterpret_cast<std::uintptr_t>( pObj ) & arenaTag ) != 0;
+  }
+
+  /**
+   * Returns true if the payload may have changed since markClean was
+   * last called. Variants start out dirty and become dirty again
+   * when they are copied or moved into, deserialized, or when a
+   * writable payload is handed out by the non-const getObject,
+   * getMutableObject, tryGetObject or getPayload (and so by
+   * Dispatcher, visit, VariantSpan and BatchDispatcher, which use
+   * them). The const accessors never write to the Variant, so writes
+   * through them must be followed by markDirty.
+   **/
+  bool isDirty() const noexcept
+  {
+    return ( reinterpret_cast<std::uintptr_t>( pObj ) & dirtyTag ) != 0;
+  }
+
+  /**
+   * Flags the payload as changed, does nothing for empty Variants.
+   **/
+  void markDirty() noexcept
+  {
+    if ( pObj != nullptr ) setTag( dirtyTag, true );
+  }
+
+  /**
+   * Flags the payload as matching its last serialized form.
+   **/
+  void markClean() noexcept
+  {
+    setTag( dirtyTag, false );
   }
 
   /**
@@ -135,10 +369,77 @@ public:
    *         otherwise this is the value returned by the object's
    *         MetaData's deserialize method.
    **/
-  bool deserialize( Json::Value& root );
+  bool deserialize( const Json::Value& root );
+
+  /**
+   * Appends the payload in the binary format generated from its
+   * type's reflected fields (see FieldList).
+   * @param out The buffer to append to.
+   * @return false if the Variant is empty or its type has no fields.
+   **/
+  bool writeBinary( std::string& out ) const;
+
+  /**
+   * Reads the payload from the binary format generated from its
+   * type's reflected fields.
+   * @param begin Advanced past the bytes which were read.
+   * @param end The end of the input.
+   * @return false if the Variant is empty, its type has no fields or
+   *         the input ended early.
+   **/
+  bool readBinary( const char*& begin, const char* end );
+
+private:
+  /**
+   * Destroys the payload, freeing its storage unless it is owned by
+   * a VariantArena, and leaves the Variant empty.
+   **/
+  void reset() noexcept;
+
+  /**
+   * Returns the payload without marking the Variant dirty.
+   **/
+  void* payload() const noexcept
+  {
+    return reinterpret_cast<void*>(
+      reinterpret_cast<std::uintptr_t>( pObj ) &
+      ~( arenaTag | dirtyTag ) );
+  }
+
+  /**
+   * Marks the Variant dirty, only writing when it is clean, so
+   * repeated access does not store to the Variant.
+   **/
+  void touch() noexcept
+  {
+    if ( pObj != nullptr && !isDirty() ) setTag( dirtyTag, true );
+  }
+
+  void setTag( std::uintptr_t tag, bool set ) noexcept
+  {
+    std::uintptr_t bits = reinterpret_cast<std::uintptr_t>( pObj );
+    pObj = reinterpret_cast<void*>( set ? bits | tag : bits & ~tag );
+  }
 };
 
 } /* namespace meta */
 } /* namespace tetra */
 
+namespace std
+{
+
+/**
+ * Lets Variants be keys of unordered containers.
+ **/
+template <>
+struct hash<tetra::meta::Variant>
+{
+  std::size_t operator()( const tetra::meta::Variant& variant ) const
+  {
+    return variant.hash();
+  }
+};
+
+} /* namespace std */
+
 #endif
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef TETRA_META_VARIANTARENA_HPP
+#define TETRA_META_VARIANTARENA_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Compacts the payloads of a collection of Variants into contiguous
+ * storage.
+ * Payloads which have been allocated one by one end up scattered over
+ * the heap after a long run, so iterating over the Variants misses
+ * the cache on nearly every payload. compact() relocates every
+ * payload into one block owned by the arena, in iteration order, and
+ * repoints the Variants, which keep working as before: destroying,
+ * moving or reassigning them destroys an arena payload in place.
+ * The arena must outlive the Variants whose payloads it holds, or
+ * those Variants must be compacted into another arena first. The
+ * storage of destroyed payloads is only reclaimed with the arena.
+ **/
+class VariantArena
+{
+  std::vector<void*> blocks;
+  std::size_t reservedBytes{0};
+
+public:
+  VariantArena() = default;
+
+  /**
+   * Frees the arena's blocks. The payloads in them must already have
+   * been destroyed or relocated.
+   **/
+  ~VariantArena();
+
+  VariantArena( const VariantArena& ) = delete;
+  VariantArena& operator=( const VariantArena& ) = delete;
+
+  /**
+   * Relocates the payloads of the Variants into a new block, in
+   * order. Payloads which were allocated on their own are freed,
+   * payloads in an arena only leave their storage behind.
+   * @throws Whatever a payload's move constructor throws. The
+   *         payloads before it stay in the new block, it and the ones
+   *         after it keep their storage.
+   * @return The number of payloads relocated.
+   **/
+  std::size_t compact( Variant* first, Variant* last );
+
+  std::size_t compact( std::vector<Variant>& variants )
+  {
+    return compact( variants.data(), variants.data() + variants.size() );
+  }
+
+  /**
+   * Returns the number of blocks, one per compact call that had
+   * payloads to relocate.
+   **/
+  std::size_t getBlockCount() const noexcept;
+
+  /**
+   * Returns the number of bytes held in blocks.
+   **/
+  std::size_t getReservedBytes() const noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
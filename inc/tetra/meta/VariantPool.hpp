@@ -0,0 +1,280 @@
+#pragma once
+#ifndef TETRA_META_VARIANTPOOL_HPP
+#define TETRA_META_VARIANTPOOL_HPP
+
+#include <tetra/meta/MetaArray.hpp>
+#include <tetra/meta/Variant.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Thrown when a VariantPool can not represent a new object in a
+ * VariantHandle, because its type index or slot does not fit.
+ **/
+class HandleOverflowException : public std::runtime_error
+{
+public:
+  inline HandleOverflowException()
+    : std::runtime_error{"Value does not fit in a VariantHandle!"}
+  { }
+};
+
+/**
+ * Refers to an object in a VariantPool. Packs the type index (16
+ * bits), the generation of its slot (16 bits) and the slot (32 bits)
+ * into 64 bits, so at most 65536 types can be pooled. The default
+ * constructed handle is null.
+ **/
+class VariantHandle
+{
+  std::uint64_t bits{0};
+
+public:
+  static const std::size_t maxTypeIndex = 0xFFFF;
+  static const std::size_t maxSlot = 0xFFFFFFFE;
+
+  VariantHandle() = default;
+
+  VariantHandle( std::size_t typeIndex, std::uint32_t slot,
+                 std::uint16_t generation ) noexcept
+    : bits{( std::uint64_t( typeIndex ) << 48 ) |
+           ( std::uint64_t( generation ) << 32 ) | slot}
+  { }
+
+  /**
+   * Same as the constructor, but checks that the values fit their
+   * fields instead of truncating them.
+   * @throws HandleOverflowException if the type index is above
+   *         maxTypeIndex or the slot above maxSlot.
+   **/
+  static VariantHandle make( std::size_t typeIndex, std::size_t slot,
+                             std::uint16_t generation )
+  {
+    if ( typeIndex > maxTypeIndex || slot > maxSlot )
+    {
+      throw HandleOverflowException{};
+    }
+
+    return {typeIndex, std::uint32_t( slot ), generation};
+  }
+
+  std::size_t getTypeIndex() const noexcept
+  {
+    return std::size_t( bits >> 48 );
+  }
+
+  std::uint16_t getGeneration() const noexcept
+  {
+    return std::uint16_t( bits >> 32 );
+  }
+
+  std::uint32_t getSlot() const noexcept
+  {
+    return std::uint32_t( bits );
+  }
+
+  bool isNull() const noexcept { return bits == 0; }
+
+  std::uint64_t getBits() const noexcept { return bits; }
+
+  bool operator==( const VariantHandle& rhs ) const noexcept
+  {
+    return bits == rhs.bits;
+  }
+
+  bool operator!=( const VariantHandle& rhs ) const noexcept
+  {
+    return bits != rhs.bits;
+  }
+};
+
+/**
+ * Owns objects of any type and refers to them by VariantHandle
+ * instead of by pointer.
+ * Objects of each type are densely packed in one MetaArray, and a
+ * slot table maps handles to their current index, so lookups are
+ * O(1) and destroying an object moves the last object of its type
+ * into the hole without invalidating any handle. Each slot counts
+ * how often it was reused, so handles to destroyed objects are
+ * detected rather than resolved to whatever took their slot.
+ * Pointers to objects are invalidated by create and destroy.
+ **/
+class VariantPool
+{
+  static const std::uint32_t noIndex = 0xFFFFFFFF;
+  static const std::uint16_t lastGeneration = 0xFFFF;
+
+  struct Slot
+  {
+    std::uint32_t index;        // into values, noIndex when free
+    std::uint16_t generation;
+  };
+
+  struct Pool
+  {
+    MetaArray values;
+    std::vector<std::uint32_t> owners;  // index -> slot
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+
+    explicit Pool( const MetaData& metaData ) : values{metaData}
+    { }
+  };
+
+  // indexed by MetaData::getTypeIndex
+  std::vector<std::unique_ptr<Pool>> pools;
+
+public:
+  /**
+   * Creates a default constructed instance of the type. The pool is
+   * unchanged if construction throws.
+   * @throws HandleOverflowException if the type's index or the new
+   *         slot does not fit in a VariantHandle.
+   * @return The handle of the new object.
+   **/
+  VariantHandle create( const MetaData& metaData );
+
+  /**
+   * Creates an instance of T from the value. If assigning the value
+   * throws, the instance is destroyed again.
+   **/
+  template <typename T>
+  VariantHandle create( T&& value )
+  {
+    using Type = typename std::remove_reference<T>::type;
+    VariantHandle handle = create( MetaData::get<Type>() );
+    try
+    {
+      *reinterpret_cast<Type*>( getPayload( handle ) ) =
+        std::forward<T>( value );
+    }
+    catch ( ... )
+    {
+      destroy( handle );
+      throw;
+    }
+
+    return handle;
+  }
+
+  /**
+   * Creates a copy of the Variant's payload. If the copy throws, the
+   * instance is destroyed again.
+   * @throws TypeCastException if the Variant is empty.
+   **/
+  VariantHandle copy( const Variant& variant );
+
+  /**
+   * Destroys the object the handle refers to.
+   * @return false if the handle is null or dangling.
+   **/
+  bool destroy( VariantHandle handle ) noexcept;
+
+  /**
+   * Returns true if the handle refers to a live object.
+   **/
+  bool isValid( VariantHandle handle ) const noexcept;
+
+  /**
+   * Returns the object the handle refers to, or nullptr if the handle
+   * is null or dangling.
+   **/
+  void* getPayload( VariantHandle handle ) const noexcept;
+
+  /**
+   * Returns the MetaData of the type the handle refers to, or nullptr
+   * if no object of that type was ever created.
+   **/
+  const MetaData* getMetaData( VariantHandle handle ) const noexcept;
+
+  /**
+   * Returns the object the handle refers to, or nullptr if the handle
+   * is dangling or refers to another type.
+   **/
+  template <typename T>
+  T* tryGet( VariantHandle handle ) const noexcept
+  {
+    if ( handle.getTypeIndex() != MetaData::get<T>().getTypeIndex() )
+      return nullptr;
+
+    return reinterpret_cast<T*>( getPayload( handle ) );
+  }
+
+  /**
+   * Returns the object the handle refers to.
+   * @throws TypeCastException if the handle is dangling or refers to
+   *         another type.
+   **/
+  template <typename T>
+  T& get( VariantHandle handle ) const
+  {
+    T* value = tryGet<T>( handle );
+    if ( value == nullptr )
+    {
+      throw TypeCastException{};
+    }
+
+    return *value;
+  }
+
+  /**
+   * Returns the number of live objects.
+   **/
+  std::size_t size() const noexcept;
+
+  /**
+   * Returns the number of live objects of the type.
+   **/
+  std::size_t size( const MetaData& metaData ) const noexcept;
+
+  /**
+   * Calls f( handle, object ) for every object of type T, in storage
+   * order.
+   **/
+  template <typename T, typename F>
+  void forEach( F&& f ) const
+  {
+    const MetaData& metaData = MetaData::get<T>();
+    Pool* pool = findPool( metaData );
+    if ( pool == nullptr ) return;
+
+    T* values = reinterpret_cast<T*>( pool->values.data() );
+    for ( std::size_t i = 0; i < pool->owners.size(); ++i )
+    {
+      std::uint32_t slot = pool->owners[i];
+      f( VariantHandle{metaData.getTypeIndex(), slot,
+                       pool->slots[slot].generation},
+         values[i] );
+    }
+  }
+
+  /**
+   * Releases the unused storage of every type. Handles stay valid.
+   **/
+  void shrinkToFit();
+
+  /**
+   * Releases the unused storage of one type. Handles stay valid.
+   **/
+  void shrinkToFit( const MetaData& metaData );
+
+private:
+  Pool* findPool( const MetaData& metaData ) const noexcept;
+  Pool* findPool( VariantHandle handle ) const noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef TETRA_META_VARIANTQUEUE_HPP
+#define TETRA_META_VARIANTQUEUE_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Bounded lock-free queue of Variants for many producer threads and a
+ * single consumer thread.
+ * Variants are moved in and out of the ring, which only exchanges
+ * their payload pointers, so payloads are never copied. Each cell
+ * carries a sequence number which tells producers and the consumer
+ * whether it is free or filled, so the only contended write is the
+ * producers' claim of the head position.
+ **/
+class VariantQueue
+{
+  static constexpr std::size_t cacheLineSize = 64;
+
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence;
+    Variant variant;
+  };
+
+  Cell* cells{nullptr};
+  std::size_t mask{0};
+
+  // producers and the consumer write to different cache lines
+  char headPadding[cacheLineSize];
+  std::atomic<std::size_t> head{0};
+  char tailPadding[cacheLineSize - sizeof( std::atomic<std::size_t> )];
+  std::size_t tail{0};
+  char endPadding[cacheLineSize - sizeof( std::size_t )];
+
+public:
+  /**
+   * Creates an empty queue.
+   * @param capacity The maximum number of queued Variants, rounded up
+   *        to a power of two.
+   **/
+  explicit VariantQueue( std::size_t capacity );
+
+  /**
+   * Destroys the Variants which are still queued.
+   **/
+  ~VariantQueue();
+
+  VariantQueue( const VariantQueue& ) = delete;
+  VariantQueue& operator=( const VariantQueue& ) = delete;
+
+  /**
+   * Returns the maximum number of queued Variants.
+   **/
+  std::size_t getCapacity() const noexcept;
+
+  /**
+   * Moves the Variant into the queue, safe to call from any thread.
+   * @param variant Left empty on success, untouched if the queue was
+   *        full.
+   * @return false if the queue was full.
+   **/
+  bool tryPush( Variant&& variant ) noexcept;
+
+  /**
+   * Moves the oldest Variant out of the queue. Only one thread may
+   * pop at a time.
+   * @param out Receives the Variant, its previous payload is
+   *        destroyed.
+   * @return false if the queue was empty.
+   **/
+  bool tryPop( Variant& out ) noexcept;
+
+  /**
+   * Moves up to maxCount of the oldest Variants out of the queue.
+   * Only one thread may pop at a time.
+   * @param out Output iterator which is assigned each Variant as an
+   *        rvalue, for example a std::back_inserter.
+   * @return The number of Variants popped.
+   **/
+  template <typename OutputIt>
+  std::size_t popBatch( OutputIt out, std::size_t maxCount )
+  {
+    std::size_t count = 0;
+    for ( ; count < maxCount; ++count )
+    {
+      Cell& cell = cells[tail & mask];
+      if ( cell.sequence.load( std::memory_order_acquire ) != tail + 1 )
+        break;
+
+      *out = std::move( cell.variant );
+      ++out;
+      cell.sequence.store( tail + mask + 1, std::memory_order_release );
+      ++tail;
+    }
+
+    return count;
+  }
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,228 @@
+#pragma once
+#ifndef TETRA_META_VARIANTSEQUENCE_HPP
+#define TETRA_META_VARIANTSEQUENCE_HPP
+
+#include <tetra/meta/Memory.hpp>
+#include <tetra/meta/Variant.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Append-only sequence of objects of any type, packed back to back
+ * in large blocks. Each object is stored as a record: a small header
+ * with its MetaData, followed by the payload at the alignment its
+ * type requires. Appending is a pointer bump in the common case, and
+ * clear() destroys the payloads in one pass and keeps the blocks for
+ * reuse, which suits lists that are rebuilt every frame.
+ * Pointers to payloads stay valid until clear().
+ **/
+class VariantSequence
+{
+public:
+  /**
+   * An object in the sequence.
+   **/
+  class Record
+  {
+    friend class VariantSequence;
+
+    const MetaData* metaData;
+    Record* next;
+
+  public:
+    const MetaData& getMetaData() const noexcept
+    {
+      return *metaData;
+    }
+
+    bool holds( const MetaData& metaData ) const noexcept
+    {
+      return this->metaData == &metaData;
+    }
+
+    /**
+     * Returns the payload, which follows the header.
+     **/
+    void* getPayload() const noexcept
+    {
+      std::uintptr_t end =
+        reinterpret_cast<std::uintptr_t>( this ) + sizeof( Record );
+      return reinterpret_cast<void*>(
+        alignUp( end, metaData->getAlignment() ) );
+    }
+
+    /**
+     * Returns the payload, or nullptr if the type requested is
+     * incompatable with the type of the payload.
+     **/
+    template <typename T>
+    T* tryGetObject() const noexcept
+    {
+      if ( !holds( MetaData::get<T>() ) ) return nullptr;
+
+      return reinterpret_cast<T*>( getPayload() );
+    }
+
+    /**
+     * Returns the payload.
+     * @throws TypeCastException if the type requested is incompatable
+     *         with the type of the payload.
+     **/
+    template <typename T>
+    T& getObject() const
+    {
+      T* obj = tryGetObject<T>();
+      if ( obj == nullptr )
+      {
+        throw TypeCastException{};
+      }
+
+      return *obj;
+    }
+  };
+
+  /**
+   * Forward iterator over the records, in the order they were
+   * appended.
+   **/
+  class Iterator
+  {
+    Record* record;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Record;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Record*;
+    using reference = Record&;
+
+    explicit Iterator( Record* record = nullptr ) noexcept
+      : record{record}
+    { }
+
+    Record& operator*() const noexcept { return *record; }
+    Record* operator->() const noexcept { return record; }
+
+    Iterator& operator++() noexcept
+    {
+      record = record->next;
+      return *this;
+    }
+
+    Iterator operator++( int ) noexcept
+    {
+      Iterator previous = *this;
+      record = record->next;
+      return previous;
+    }
+
+    bool operator==( const Iterator& rhs ) const noexcept
+    {
+      return record == rhs.record;
+    }
+
+    bool operator!=( const Iterator& rhs ) const noexcept
+    {
+      return record != rhs.record;
+    }
+  };
+
+private:
+  struct Block
+  {
+    char* memory;
+    std::size_t capacity;
+  };
+
+  std::size_t blockSize;
+  std::vector<Block> blocks;
+  std::size_t currentBlock{0};
+  std::size_t used{0};
+
+  Record* first{nullptr};
+  Record* last{nullptr};
+  std::size_t count{0};
+
+public:
+  /**
+   * Creates an empty sequence.
+   * @param blockSize Bytes per block, records larger than a block get
+   *        a block of their own.
+   **/
+  explicit VariantSequence( std::size_t blockSize = 65536 ) noexcept;
+
+  /**
+   * Destroys every payload and frees the blocks.
+   **/
+  ~VariantSequence();
+
+  VariantSequence( const VariantSequence& ) = delete;
+  VariantSequence& operator=( const VariantSequence& ) = delete;
+
+  /**
+   * Appends a default constructed instance of the type.
+   * @return The new payload.
+   **/
+  void* emplace( const MetaData& metaData );
+
+  /**
+   * Appends an instance of T constructed from the value.
+   * @return The new object.
+   **/
+  template <typename T,
+            typename Type = typename std::decay<T>::type,
+            typename = typename std::enable_if<
+              !std::is_same<Type, Variant>::value>::type>
+  Type& append( T&& value )
+  {
+    Record& record = allocate( MetaData::get<Type>() );
+    Type* obj =
+      new ( record.getPayload() ) Type( std::forward<T>( value ) );
+    link( record );
+
+    return *obj;
+  }
+
+  /**
+   * Appends a copy of the Variant's payload.
+   * @throws TypeCastException if the Variant is empty.
+   **/
+  void* append( const Variant& variant );
+
+  Iterator begin() const noexcept { return Iterator{first}; }
+  Iterator end() const noexcept { return Iterator{}; }
+
+  std::size_t size() const noexcept;
+  bool empty() const noexcept;
+
+  /**
+   * Destroys every payload which is not trivially destructible and
+   * rewinds the blocks, which are kept for reuse.
+   **/
+  void clear() noexcept;
+
+  /**
+   * Returns the number of bytes held in blocks.
+   **/
+  std::size_t getReservedBytes() const noexcept;
+
+private:
+  Record& allocate( const MetaData& metaData );
+  void link( Record& record ) noexcept;
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
@@ -0,0 +1,216 @@
+#pragma once
+#ifndef TETRA_META_VARIANTSPAN_HPP
+#define TETRA_META_VARIANTSPAN_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * A random access range of T& over Variants which all hold a T.
+ * The payload types are checked once, when the span is created, so
+ * element access is a pointer load and loops over the span have no
+ * per element type checks or throws in them. Any element may be
+ * written through the span, so creating it marks every Variant dirty
+ * (see Variant::isDirty) and element access never stores to them.
+ * Writes made after the Variants were marked clean again, such as
+ * by a SerializationCache, are not tracked, so use a new span for
+ * each pass of writes.
+ * @templateParam T The payload type of every Variant in the range.
+ **/
+template <typename T>
+class VariantSpan
+{
+  Variant* first;
+  std::size_t count;
+
+public:
+  class Iterator
+  {
+    Variant* current;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    explicit Iterator( Variant* current = nullptr ) noexcept
+      : current{current}
+    { }
+
+    T& operator*() const noexcept
+    {
+      return payloadOf( *current );
+    }
+
+    T* operator->() const noexcept
+    {
+      return &payloadOf( *current );
+    }
+
+    T& operator[]( difference_type n ) const noexcept
+    {
+      return payloadOf( current[n] );
+    }
+
+    Iterator& operator++() noexcept { ++current; return *this; }
+    Iterator& operator--() noexcept { --current; return *this; }
+
+    Iterator operator++( int ) noexcept
+    {
+      return Iterator{current++};
+    }
+
+    Iterator operator--( int ) noexcept
+    {
+      return Iterator{current--};
+    }
+
+    Iterator& operator+=( difference_type n ) noexcept
+    {
+      current += n;
+      return *this;
+    }
+
+    Iterator& operator-=( difference_type n ) noexcept
+    {
+      current -= n;
+      return *this;
+    }
+
+    Iterator operator+( difference_type n ) const noexcept
+    {
+      return Iterator{current + n};
+    }
+
+    Iterator operator-( difference_type n ) const noexcept
+    {
+      return Iterator{current - n};
+    }
+
+    friend Iterator operator+( difference_type n,
+                               const Iterator& iter ) noexcept
+    {
+      return iter + n;
+    }
+
+    difference_type operator-( const Iterator& rhs ) const noexcept
+    {
+      return current - rhs.current;
+    }
+
+    bool operator==( const Iterator& rhs ) const noexcept
+    {
+      return current == rhs.current;
+    }
+
+    bool operator!=( const Iterator& rhs ) const noexcept
+    {
+      return current != rhs.current;
+    }
+
+    bool operator<( const Iterator& rhs ) const noexcept
+    {
+      return current < rhs.current;
+    }
+
+    bool operator>( const Iterator& rhs ) const noexcept
+    {
+      return current > rhs.current;
+    }
+
+    bool operator<=( const Iterator& rhs ) const noexcept
+    {
+      return current <= rhs.current;
+    }
+
+    bool operator>=( const Iterator& rhs ) const noexcept
+    {
+      return current >= rhs.current;
+    }
+  };
+
+  /**
+   * Creates a span over the Variants, checking their payload types
+   * and marking them dirty.
+   * @throws TypeCastException if a Variant does not hold a T, before
+   *         any Variant is marked.
+   **/
+  VariantSpan( Variant* first, Variant* last )
+    : first{first}, count{std::size_t( last - first )}
+  {
+    const MetaData& metaData = MetaData::get<T>();
+    for ( Variant* variant = first; variant != last; ++variant )
+    {
+      if ( !variant->holds( metaData ) )
+      {
+        throw TypeCastException{};
+      }
+    }
+
+    markDirty();
+  }
+
+  explicit VariantSpan( std::vector<Variant>& variants )
+    : VariantSpan{variants.data(), variants.data() + variants.size()}
+  { }
+
+  /**
+   * Creates a span over Variants which the caller knows hold a T.
+   * The types are only checked by assert, so in release builds a
+   * wrong type is undefined behaviour. The Variants are marked dirty.
+   **/
+  static VariantSpan trusted( Variant* first, Variant* last ) noexcept
+  {
+#ifndef NDEBUG
+    for ( Variant* variant = first; variant != last; ++variant )
+      assert( variant->holds( MetaData::get<T>() ) );
+#endif
+
+    VariantSpan span{first, std::size_t( last - first ), 0};
+    span.markDirty();
+    return span;
+  }
+
+  Iterator begin() const noexcept { return Iterator{first}; }
+  Iterator end() const noexcept { return Iterator{first + count}; }
+  std::size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0; }
+
+  T& operator[]( std::size_t i ) const noexcept
+  {
+    return payloadOf( first[i] );
+  }
+
+private:
+  // unchecked
+  VariantSpan( Variant* first, std::size_t count, int ) noexcept
+    : first{first}, count{count}
+  { }
+
+  void markDirty() noexcept
+  {
+    for ( std::size_t i = 0; i < count; ++i ) first[i].markDirty();
+  }
+
+  // the const getPayload, which does not store to the Variant
+  static T& payloadOf( const Variant& variant ) noexcept
+  {
+    return *reinterpret_cast<T*>( variant.getPayload() );
+  }
+};
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
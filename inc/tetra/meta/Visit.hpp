@@ -0,0 +1,182 @@
+#pragma once
+#ifndef TETRA_META_VISIT_HPP
+#define TETRA_META_VISIT_HPP
+
+#include <tetra/meta/Variant.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tetra
+{
+namespace meta
+{
+
+/**
+ * Combines several callables into one overload set, usually a set of
+ * lambdas which each accept a different payload type.
+ * Use the overloaded function to create one.
+ **/
+template <typename... Fs>
+struct Overloaded;
+
+template <typename F>
+struct Overloaded<F> : F
+{
+  Overloaded( F f ) : F( std::move( f ) ) { }
+
+  using F::operator();
+};
+
+template <typename F, typename... Rest>
+struct Overloaded<F, Rest...> : F, Overloaded<Rest...>
+{
+  Overloaded( F f, Rest... rest )
+    : F( std::move( f ) )
+    , Overloaded<Rest...>( std::move( rest )... )
+  { }
+
+  using F::operator();
+  using Overloaded<Rest...>::operator();
+};
+
+/**
+ * Creates an overload set from the callables:
+ *   overloaded( []( Foo& ) { ... }, []( Bar& ) { ... } )
+ **/
+template <typename... Fs>
+Overloaded<Fs...> overloaded( Fs... fs )
+{
+  return {std::move( fs )...};
+}
+
+namespace detail
+{
+
+template <typename T, typename... Ts>
+struct First
+{
+  using type = T;
+};
+
+/**
+ * Maps type indices to 1-based positions in the type list, 0 means
+ * the type is not in the list. Built once per type list.
+ **/
+template <typename... Ts>
+struct PositionTable
+{
+  std::vector<std::size_t> positions;
+
+  PositionTable()
+  {
+    const MetaData* types[] = {&MetaData::get<Ts>()...};
+    for ( std::size_t i = 0; i < sizeof...( Ts ); ++i )
+    {
+      std::size_t index = types[i]->getTypeIndex();
+      if ( index >= positions.size() )
+        positions.resize( index + 1, 0 );
+
+      // the first occurrence wins if a type is listed twice
+      if ( positions[index] == 0 ) positions[index] = i + 1;
+    }
+  }
+
+  std::size_t positionOf( const Variant& variant ) const noexcept
+  {
+    if ( variant.isEmpty() ) return 0;
+
+    std::size_t index = variant.getMetaData().getTypeIndex();
+    return index < positions.size() ? positions[index] : 0;
+  }
+};
+
+/**
+ * Compares the position against compile-time constants, which lets
+ * the compiler lower the recursion into a switch with each handler
+ * inlined into its case.
+ **/
+template <typename Result, std::size_t Position, typename... Ts>
+struct VisitCase;
+
+template <typename Result, std::size_t Position, typename T,
+          typename... Ts>
+struct VisitCase<Result, Position, T, Ts...>
+{
+  template <typename Visitor>
+  static Result visit( std::size_t position, void* payload,
+                       Visitor& visitor )
+  {
+    if ( position == Position )
+      return visitor( *reinterpret_cast<T*>( payload ) );
+
+    return VisitCase<Result, Position + 1, Ts...>::visit(
+      position, payload, visitor );
+  }
+};
+
+template <typename Result, std::size_t Position>
+struct VisitCase<Result, Position>
+{
+  template <typename Visitor>
+  static Result visit( std::size_t, void*, Visitor& )
+  {
+    throw TypeCastException{};
+  }
+};
+
+} /* namespace detail */
+
+/**
+ * Calls the visitor with the Variant's payload, cast to whichever of
+ * the listed types it holds. The set of types is closed at compile
+ * time, so the visitor can be inlined at each call site instead of
+ * being called through a function pointer.
+ * @throws TypeCastException if the payload is not one of the listed
+ *         types, or the Variant is empty.
+ * @templateParam Ts The payload types to accept.
+ * @param variant The Variant to visit, which is marked dirty.
+ * @param visitor Callable with a T& for each of the types Ts, all
+ *        overloads must have the same return type.
+ * @return The value returned by the visitor.
+ **/
+template <typename... Ts, typename Visitor>
+typename std::result_of<
+  Visitor&( typename detail::First<Ts...>::type& )>::type
+visit( Variant& variant, Visitor&& visitor )
+{
+  using Result = typename std::result_of<
+    Visitor&( typename detail::First<Ts...>::type& )>::type;
+
+  static const detail::PositionTable<Ts...> table{};
+
+  std::size_t position = table.positionOf( variant );
+  return detail::VisitCase<Result, 1, Ts...>::visit(
+    position, position != 0 ? variant.getPayload() : nullptr,
+    visitor );
+}
+
+/**
+ * Same as visit, but does not mark the Variant dirty, so writes
+ * through the payload must be followed by Variant::markDirty.
+ **/
+template <typename... Ts, typename Visitor>
+typename std::result_of<
+  Visitor&( typename detail::First<Ts...>::type& )>::type
+visit( const Variant& variant, Visitor&& visitor )
+{
+  using Result = typename std::result_of<
+    Visitor&( typename detail::First<Ts...>::type& )>::type;
+
+  static const detail::PositionTable<Ts...> table{};
+
+  return detail::VisitCase<Result, 1, Ts...>::visit(
+    table.positionOf( variant ), variant.getPayload(), visitor );
+}
+
+} /* namespace meta */
+} /* namespace tetra */
+
+#endif
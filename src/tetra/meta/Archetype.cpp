@@ -0,0 +1,157 @@
+#include <tetra/meta/Archetype.hpp>
+
+#include <tetra/meta/Memory.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+const size_t Archetype::chunkSize;
+const size_t Archetype::noColumn;
+
+namespace
+{
+
+// chunks start on a cache line, so columns do not share lines
+const size_t cacheLineSize = 64;
+
+/**
+ * Computes the column offsets for a chunk with rowCapacity rows.
+ * offsets[0] is the entity column. Returns the bytes needed.
+ **/
+size_t layoutColumns( const vector<const MetaData*>& types,
+                      size_t rowCapacity, vector<size_t>& offsets )
+{
+  offsets.assign( 1, 0 );
+  size_t end = rowCapacity * sizeof( Entity );
+  for ( const MetaData* type : types )
+  {
+    size_t offset = alignUp( end, type->getAlignment() );
+    offsets.push_back( offset );
+    end = offset + rowCapacity * type->getSize();
+  }
+
+  return end;
+}
+
+} /* namespace */
+
+Archetype::Archetype( vector<const MetaData*> types )
+  : types( move( types ) )
+{
+  sort( this->types.begin(), this->types.end(),
+        []( const MetaData* lhs, const MetaData* rhs ) {
+          return lhs->getTypeIndex() < rhs->getTypeIndex();
+        } );
+
+  size_t rowBytes = sizeof( Entity );
+  chunkAlignment = cacheLineSize;
+  for ( const MetaData* type : this->types )
+  {
+    rowBytes += type->getSize();
+    chunkAlignment = max( chunkAlignment, type->getAlignment() );
+  }
+
+  // start from the unpadded estimate and shrink until the padded
+  // layout fits, a chunk always holds at least one row
+  rowCapacity = max<size_t>( 1, chunkSize / rowBytes );
+  while ( rowCapacity > 1 &&
+          layoutColumns( this->types, rowCapacity, offsets ) >
+            chunkSize )
+    --rowCapacity;
+
+  chunkBytes = alignUp(
+    max( chunkSize, layoutColumns( this->types, rowCapacity, offsets ) ),
+    chunkAlignment );
+}
+
+Archetype::~Archetype()
+{
+  for ( const Chunk& chunk : chunks )
+  {
+    for ( size_t column = 0; column < types.size(); ++column )
+      for ( size_t row = 0; row < chunk.count; ++row )
+        types[column]->destroyInstanceAt(
+          chunk.memory + offsets[column + 1] +
+          row * types[column]->getSize() );
+
+    alignedFree( chunk.memory );
+  }
+}
+
+const vector<const MetaData*>& Archetype::getTypes() const noexcept
+{
+  return types;
+}
+
+size_t Archetype::columnOf( const MetaData& metaData ) const noexcept
+{
+  for ( size_t column = 0; column < types.size(); ++column )
+    if ( types[column] == &metaData ) return column;
+
+  return noColumn;
+}
+
+size_t Archetype::getRowCapacity() const noexcept
+{
+  return rowCapacity;
+}
+
+size_t Archetype::getChunkCount() const noexcept
+{
+  return chunks.size();
+}
+
+size_t Archetype::size() const noexcept
+{
+  return chunks.empty()
+           ? 0
+           : ( chunks.size() - 1 ) * rowCapacity + chunks.back().count;
+}
+
+Archetype::Location Archetype::pushRow( Entity entity )
+{
+  if ( chunks.empty() || chunks.back().count == rowCapacity )
+  {
+    // grow the list first, so the push can not throw and leak the chunk
+    if ( chunks.size() == chunks.capacity() )
+      chunks.reserve( chunks.empty() ? 4 : chunks.size() * 2 );
+    chunks.push_back( {reinterpret_cast<char*>( alignedAllocate(
+                         chunkBytes, chunkAlignment ) ),
+                       0} );
+  }
+
+  Location location{chunks.size() - 1, chunks.back().count++};
+  entities( location.chunk )[location.row] = entity;
+
+  return location;
+}
+
+void Archetype::popRow() noexcept
+{
+  if ( --chunks.back().count == 0 )
+  {
+    alignedFree( chunks.back().memory );
+    chunks.pop_back();
+  }
+}
+
+Archetype::Location
+Archetype::removeRow( const Location& location ) noexcept
+{
+  Location last{chunks.size() - 1, chunks.back().count - 1};
+  if ( last.chunk != location.chunk || last.row != location.row )
+  {
+    for ( size_t column = 0; column < types.size(); ++column )
+      types[column]->relocateInstance( at( location, column ),
+                                       at( last, column ) );
+
+    entities( location.chunk )[location.row] =
+      entities( last.chunk )[last.row];
+  }
+
+  popRow();
+  return last;
+}
@@ -0,0 +1,201 @@
+#include <tetra/meta/ArchetypeStore.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+void* ArchetypeStore::add( Entity entity, const MetaData& metaData )
+{
+  if ( entity > maxEntity ) throw InvalidEntityException{};
+  if ( entity >= records.size() )
+    records.resize( size_t{entity} + 1, Record{nullptr, {0, 0}} );
+
+  Archetype* source = records[entity].archetype;
+  if ( source != nullptr && source->contains( metaData ) )
+    return get( entity, metaData );
+
+  Archetype* target = withType( source, metaData );
+  Archetype::Location location = target->pushRow( entity );
+
+  void* component =
+    target->at( location, target->columnOf( metaData ) );
+  try
+  {
+    metaData.constructInstanceAt( component );
+  }
+  catch ( ... )
+  {
+    target->popRow();
+    throw;
+  }
+
+  moveEntity( entity, target, location );
+  return component;
+}
+
+bool ArchetypeStore::remove( Entity entity, const MetaData& metaData )
+{
+  if ( entity >= records.size() ) return false;
+
+  Archetype* source = records[entity].archetype;
+  if ( source == nullptr || !source->contains( metaData ) )
+    return false;
+
+  Archetype* target = withoutType( source, metaData );
+  if ( target == nullptr )
+  {
+    moveEntity( entity, nullptr, {0, 0} );
+  }
+  else
+  {
+    moveEntity( entity, target, target->pushRow( entity ) );
+  }
+
+  return true;
+}
+
+void ArchetypeStore::removeAll( Entity entity ) noexcept
+{
+  if ( entity < records.size() ) moveEntity( entity, nullptr, {0, 0} );
+}
+
+void* ArchetypeStore::get( Entity entity,
+                           const MetaData& metaData ) const noexcept
+{
+  if ( entity >= records.size() ) return nullptr;
+
+  const Record& record = records[entity];
+  if ( record.archetype == nullptr ) return nullptr;
+
+  size_t column = record.archetype->columnOf( metaData );
+  if ( column == Archetype::noColumn ) return nullptr;
+
+  return record.archetype->at( record.location, column );
+}
+
+const Archetype* ArchetypeStore::getArchetype( Entity entity ) const
+  noexcept
+{
+  return entity < records.size() ? records[entity].archetype : nullptr;
+}
+
+const Query& ArchetypeStore::query( vector<const MetaData*> types )
+{
+  unique_ptr<Query> created{new Query{move( types )}};
+
+  auto iter = queryIndex.find( created->getTypes() );
+  if ( iter != queryIndex.end() ) return *iter->second;
+
+  for ( const auto& archetype : archetypes )
+    created->consider( *archetype );
+
+  queries.push_back( move( created ) );
+  Query* query = queries.back().get();
+  queryIndex[query->getTypes()] = query;
+
+  return *query;
+}
+
+size_t ArchetypeStore::getArchetypeCount() const noexcept
+{
+  return archetypes.size();
+}
+
+Archetype* ArchetypeStore::withType( Archetype* from,
+                                     const MetaData& metaData )
+{
+  if ( from == nullptr ) return findOrCreate( {&metaData} );
+
+  size_t index = metaData.getTypeIndex();
+  if ( index < from->addEdges.size() && from->addEdges[index] )
+    return from->addEdges[index];
+
+  vector<const MetaData*> types = from->getTypes();
+  types.push_back( &metaData );
+  Archetype* target = findOrCreate( move( types ) );
+
+  if ( index >= from->addEdges.size() )
+    from->addEdges.resize( index + 1, nullptr );
+  from->addEdges[index] = target;
+
+  return target;
+}
+
+Archetype* ArchetypeStore::withoutType( Archetype* from,
+                                        const MetaData& metaData )
+{
+  size_t index = metaData.getTypeIndex();
+  if ( index < from->removeEdges.size() && from->removeEdges[index] )
+    return from->removeEdges[index];
+
+  vector<const MetaData*> types = from->getTypes();
+  types.erase( find( types.begin(), types.end(), &metaData ) );
+  if ( types.empty() ) return nullptr;
+
+  Archetype* target = findOrCreate( move( types ) );
+
+  if ( index >= from->removeEdges.size() )
+    from->removeEdges.resize( index + 1, nullptr );
+  from->removeEdges[index] = target;
+
+  return target;
+}
+
+Archetype* ArchetypeStore::findOrCreate( vector<const MetaData*> types )
+{
+  sort( types.begin(), types.end(),
+        []( const MetaData* lhs, const MetaData* rhs ) {
+          return lhs->getTypeIndex() < rhs->getTypeIndex();
+        } );
+
+  auto iter = archetypeIndex.find( types );
+  if ( iter != archetypeIndex.end() ) return iter->second;
+
+  archetypes.emplace_back( new Archetype{types} );
+  Archetype* archetype = archetypes.back().get();
+  archetypeIndex[move( types )] = archetype;
+
+  // a new archetype is the only thing that changes which archetypes
+  // a query matches
+  for ( const auto& query : queries ) query->consider( *archetype );
+
+  return archetype;
+}
+
+void ArchetypeStore::moveEntity(
+  Entity entity, Archetype* target,
+  Archetype::Location targetLocation ) noexcept
+{
+  Record& record = records[entity];
+  Archetype* source = record.archetype;
+
+  if ( source != nullptr )
+  {
+    const Archetype::Location hole = record.location;
+    const vector<const MetaData*>& types = source->getTypes();
+    for ( size_t column = 0; column < types.size(); ++column )
+    {
+      void* component = source->at( hole, column );
+      size_t targetColumn = target == nullptr
+                              ? Archetype::noColumn
+                              : target->columnOf( *types[column] );
+
+      if ( targetColumn == Archetype::noColumn )
+        types[column]->destroyInstanceAt( component );
+      else
+        types[column]->relocateInstance(
+          target->at( targetLocation, targetColumn ), component );
+    }
+
+    // the source's last row fills the hole, point its entity there
+    Archetype::Location last = source->removeRow( hole );
+    if ( last.chunk != hole.chunk || last.row != hole.row )
+      records[source->entities( hole.chunk )[hole.row]].location =
+        hole;
+  }
+
+  record.archetype = target;
+  record.location = targetLocation;
+}
@@ -0,0 +1,106 @@
+#include <tetra/meta/AtomicVariantSlot.hpp>
+#include <tetra/meta/Memory.hpp>
+
+#include <cstring>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+constexpr unsigned AtomicVariantSlot::freshBit;
+
+AtomicVariantSlot::AtomicVariantSlot( const MetaData& metaData )
+  : metaData{&metaData}
+{
+  if ( metaData.isTriviallyCopyable() )
+  {
+    bytes = alignedAllocate( metaData.getSize(),
+                             metaData.getAlignment() );
+    metaData.constructInstanceAt( bytes );
+  }
+  else
+  {
+    for ( auto& buffer : buffers ) buffer = Variant{metaData};
+  }
+}
+
+AtomicVariantSlot::~AtomicVariantSlot()
+{
+  if ( bytes != nullptr )
+  {
+    metaData->destroyInstanceAt( bytes );
+    alignedFree( bytes );
+  }
+}
+
+const MetaData& AtomicVariantSlot::getMetaData() const noexcept
+{
+  return *metaData;
+}
+
+bool AtomicVariantSlot::isSeqLocked() const noexcept
+{
+  return bytes != nullptr;
+}
+
+void AtomicVariantSlot::store( const Variant& value )
+{
+  if ( !value.holds( *metaData ) )
+  {
+    throw TypeCastException{};
+  }
+
+  storePayload( value.getConstPayload() );
+}
+
+void AtomicVariantSlot::load( Variant& out )
+{
+  if ( !out.holds( *metaData ) ) out = Variant{*metaData};
+
+  loadPayload( out.getPayload() );
+}
+
+void AtomicVariantSlot::storePayload( const void* payload )
+{
+  if ( bytes != nullptr )
+  {
+    // an odd sequence tells readers a store is in progress
+    size_t current = sequence.load( memory_order_relaxed );
+    sequence.store( current + 1, memory_order_relaxed );
+    atomic_thread_fence( memory_order_release );
+
+    memcpy( bytes, payload, metaData->getSize() );
+
+    sequence.store( current + 2, memory_order_release );
+    return;
+  }
+
+  // a throwing copy leaves the buffer unpublished
+  metaData->copyInstance( buffers[back].getPayload(), payload );
+  back = middle.exchange( back | freshBit, memory_order_acq_rel ) &
+         ~freshBit;
+}
+
+void AtomicVariantSlot::loadPayload( void* payload )
+{
+  if ( bytes != nullptr )
+  {
+    for ( ;; )
+    {
+      size_t before = sequence.load( memory_order_acquire );
+      if ( before & 1 ) continue;
+
+      memcpy( payload, bytes, metaData->getSize() );
+      atomic_thread_fence( memory_order_acquire );
+
+      if ( sequence.load( memory_order_relaxed ) == before ) return;
+    }
+  }
+
+  if ( middle.load( memory_order_relaxed ) & freshBit )
+  {
+    front = middle.exchange( front, memory_order_acq_rel ) & ~freshBit;
+  }
+
+  metaData->copyInstance( payload, buffers[front].getConstPayload() );
+}
@@ -0,0 +1,77 @@
+#include <tetra/meta/BatchDispatcher.hpp>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+void BatchDispatcher::setFallback( Fallback fallback )
+{
+  this->fallback = move( fallback );
+}
+
+bool BatchDispatcher::handles( const MetaData& metaData ) const noexcept
+{
+  size_t index = metaData.getTypeIndex();
+  return index < handlers.size() && handlers[index];
+}
+
+size_t BatchDispatcher::dispatch( Variant* first, Variant* last )
+{
+  // counting sort: count the payloads of each handled type, slot 0
+  // collects the unhandled ones
+  size_t count = size_t( last - first );
+  slots.resize( count );
+  offsets.assign( handlers.size() + 2, 0 );
+  for ( size_t i = 0; i < count; ++i )
+  {
+    slots[i] = slotOf( first[i] );
+    ++offsets[slots[i] + 1];
+  }
+
+  for ( size_t slot = 1; slot < offsets.size(); ++slot )
+    offsets[slot] += offsets[slot - 1];
+
+  size_t unhandled = offsets[1];
+  payloads.resize( count );
+  for ( size_t i = 0; i < count; ++i )
+  {
+    if ( slots[i] != 0 )
+      payloads[offsets[slots[i]]++] = first[i].getPayload();
+  }
+
+  // offsets[slot] now marks the end of the slot's payloads
+  size_t begin = unhandled;
+  for ( size_t index = 0; index < handlers.size(); ++index )
+  {
+    size_t end = offsets[index + 1];
+    if ( end != begin ) handlers[index]( &payloads[begin], end - begin );
+    begin = end;
+  }
+
+  if ( fallback && unhandled != 0 )
+  {
+    for ( size_t i = 0; i < count; ++i )
+    {
+      if ( slots[i] == 0 ) fallback( first[i] );
+    }
+  }
+
+  return count - unhandled;
+}
+
+void BatchDispatcher::addHandler( const MetaData& metaData,
+                                  Handler handler )
+{
+  size_t index = metaData.getTypeIndex();
+  if ( index >= handlers.size() ) handlers.resize( index + 1 );
+
+  handlers[index] = move( handler );
+}
+
+size_t BatchDispatcher::slotOf( const Variant& message ) const noexcept
+{
+  if ( message.isEmpty() ) return 0;
+
+  size_t index = message.getMetaData().getTypeIndex();
+  return index < handlers.size() && handlers[index] ? index + 1 : 0;
+}
@@ -0,0 +1,183 @@
+#include <tetra/meta/ColumnStore.hpp>
+#include <tetra/meta/Memory.hpp>
+
+#include <cstring>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+// columns start on a cache line, which also suits any SIMD width
+const size_t columnAlignment = 64;
+const size_t minimumCapacity = 16;
+
+} /* namespace */
+
+const uint32_t ColumnStore::noSlot;
+const size_t ColumnStore::npos;
+
+ColumnStore::ColumnStore( const MetaData& metaData )
+  : metaData{&metaData}
+{
+  const TypeFields* fields = metaData.getFields();
+  if ( !metaData.isTriviallyCopyable() || fields == nullptr ||
+       fields->getFields().empty() )
+    throw ColumnLayoutException{};
+
+  for ( const Field& field : fields->getFields() )
+    columns.push_back( {&field, field.metaData->getSize(), nullptr} );
+}
+
+ColumnStore::~ColumnStore()
+{
+  for ( const Column& column : columns ) alignedFree( column.data );
+}
+
+const MetaData& ColumnStore::getMetaData() const noexcept
+{
+  return *metaData;
+}
+
+size_t ColumnStore::size() const noexcept
+{
+  return owners.size();
+}
+
+size_t ColumnStore::getColumnCount() const noexcept
+{
+  return columns.size();
+}
+
+const Field& ColumnStore::getField( size_t column ) const noexcept
+{
+  return *columns[column].field;
+}
+
+void* ColumnStore::getColumn( size_t column ) const noexcept
+{
+  return columns[column].data;
+}
+
+const Entity* ColumnStore::getOwners() const noexcept
+{
+  return owners.data();
+}
+
+size_t ColumnStore::add( Entity entity, const void* value )
+{
+  if ( entity > maxEntity ) throw InvalidEntityException{};
+  if ( entity >= slots.size() )
+    slots.resize( size_t{entity} + 1, noSlot );
+
+  if ( slots[entity] == noSlot )
+  {
+    reserve( owners.size() + 1 );
+    owners.push_back( entity );
+    slots[entity] = static_cast<uint32_t>( owners.size() - 1 );
+  }
+
+  size_t slot = slots[entity];
+  store( slot, value );
+
+  return slot;
+}
+
+bool ColumnStore::remove( Entity entity ) noexcept
+{
+  size_t slot = find( entity );
+  if ( slot == npos ) return false;
+
+  size_t last = owners.size() - 1;
+  if ( slot != last )
+  {
+    for ( const Column& column : columns )
+      memcpy( column.data + slot * column.size,
+              column.data + last * column.size, column.size );
+  }
+
+  Entity moved = owners[last];
+  owners[slot] = moved;
+  owners.pop_back();
+
+  slots[moved] = static_cast<uint32_t>( slot );
+  slots[entity] = noSlot;
+
+  return true;
+}
+
+size_t ColumnStore::find( Entity entity ) const noexcept
+{
+  if ( entity >= slots.size() || slots[entity] == noSlot )
+    return npos;
+
+  return slots[entity];
+}
+
+void ColumnStore::load( size_t slot, void* value ) const noexcept
+{
+  char* out = reinterpret_cast<char*>( value );
+  for ( const Column& column : columns )
+    memcpy( out + column.field->offset,
+            column.data + slot * column.size, column.size );
+}
+
+void ColumnStore::store( size_t slot, const void* value ) noexcept
+{
+  const char* in = reinterpret_cast<const char*>( value );
+  for ( const Column& column : columns )
+    memcpy( column.data + slot * column.size,
+            in + column.field->offset, column.size );
+}
+
+size_t ColumnStore::findColumn( size_t offset,
+                                const MetaData& type ) const
+{
+  for ( size_t i = 0; i < columns.size(); ++i )
+  {
+    if ( columns[i].field->offset == offset &&
+         columns[i].field->metaData == &type )
+      return i;
+  }
+
+  throw TypeCastException{};
+}
+
+void ColumnStore::reserve( size_t minimum )
+{
+  if ( minimum <= capacity ) return;
+
+  size_t grown = capacity < minimumCapacity ? minimumCapacity
+                                            : capacity * 2;
+  if ( grown < minimum ) grown = minimum;
+
+  // allocate every column before touching any, so a failure leaves
+  // the store unchanged
+  vector<char*> grownData( columns.size(), nullptr );
+  try
+  {
+    for ( size_t i = 0; i < columns.size(); ++i )
+      grownData[i] = reinterpret_cast<char*>( alignedAllocate(
+        alignUp( grown * columns[i].size, columnAlignment ),
+        columnAlignment ) );
+  }
+  catch ( ... )
+  {
+    for ( char* data : grownData ) alignedFree( data );
+    throw;
+  }
+
+  for ( size_t i = 0; i < columns.size(); ++i )
+  {
+    if ( columns[i].data != nullptr )
+      memcpy( grownData[i], columns[i].data,
+              owners.size() * columns[i].size );
+
+    alignedFree( columns[i].data );
+    columns[i].data = grownData[i];
+  }
+
+  capacity = grown;
+}
@@ -0,0 +1,139 @@
+#include <tetra/meta/CompactVariant.hpp>
+#include <tetra/meta/Memory.hpp>
+
+#include <cstddef>
+#include <new>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+// the header sits in the bytes just before the payload, padded so
+// the payload keeps its alignment
+size_t payloadOffset( const MetaData& metaData ) noexcept
+{
+  return alignUp( sizeof( const MetaData* ), metaData.getAlignment() );
+}
+
+// operator new already aligns for every type that isn't over-aligned
+bool isOverAligned( const MetaData& metaData ) noexcept
+{
+  return metaData.getAlignment() > alignof( max_align_t );
+}
+
+} /* namespace */
+
+CompactVariant::CompactVariant( const MetaData& metaData )
+{
+  size_t offset = payloadOffset( metaData );
+  size_t size = offset + metaData.getSize();
+
+  char* block = reinterpret_cast<char*>(
+    isOverAligned( metaData )
+      ? alignedAllocate( size, metaData.getAlignment() )
+      : ::operator new( size ) );
+
+  try
+  {
+    metaData.constructInstanceAt( block + offset );
+  }
+  catch ( ... )
+  {
+    if ( isOverAligned( metaData ) )
+      alignedFree( block );
+    else
+      ::operator delete( block );
+    throw;
+  }
+
+  pObj = block + offset;
+  header( pObj ) = &metaData;
+}
+
+CompactVariant::~CompactVariant()
+{
+  reset();
+}
+
+CompactVariant::CompactVariant( CompactVariant&& variant ) noexcept
+  : pObj{variant.pObj}
+{
+  variant.pObj = nullptr;
+}
+
+CompactVariant&
+CompactVariant::operator=( CompactVariant&& variant ) noexcept
+{
+  if ( this != &variant )
+  {
+    reset();
+    pObj = variant.pObj;
+    variant.pObj = nullptr;
+  }
+
+  return *this;
+}
+
+void CompactVariant::copy( const CompactVariant& variant )
+{
+  if ( variant.isEmpty() )
+  {
+    reset();
+    return;
+  }
+
+  const MetaData& metaData = *variant.getMetaData();
+  if ( !holds( metaData ) ) *this = CompactVariant{metaData};
+
+  metaData.copyInstance( pObj, variant.pObj );
+}
+
+void CompactVariant::copy( const Variant& variant )
+{
+  if ( variant.isEmpty() )
+  {
+    reset();
+    return;
+  }
+
+  const MetaData& metaData = variant.getMetaData();
+  if ( !holds( metaData ) ) *this = CompactVariant{metaData};
+
+  metaData.copyInstance( pObj, variant.getConstPayload() );
+}
+
+bool CompactVariant::serialize( Json::Value& root ) const
+{
+  if ( isEmpty() || !getMetaData()->canSerialize() )
+    return false;
+
+  return getMetaData()->serializeInstance( pObj, root );
+}
+
+bool CompactVariant::deserialize( const Json::Value& root )
+{
+  if ( isEmpty() || !getMetaData()->canSerialize() )
+    return false;
+
+  return getMetaData()->deserializeInstance( pObj, root );
+}
+
+void CompactVariant::reset() noexcept
+{
+  if ( pObj == nullptr ) return;
+
+  const MetaData& metaData = *header( pObj );
+  char* block =
+    reinterpret_cast<char*>( pObj ) - payloadOffset( metaData );
+
+  metaData.destroyInstanceAt( pObj );
+  if ( isOverAligned( metaData ) )
+    alignedFree( block );
+  else
+    ::operator delete( block );
+
+  pObj = nullptr;
+}
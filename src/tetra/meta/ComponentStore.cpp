@@ -0,0 +1,96 @@
+#include <tetra/meta/ComponentStore.hpp>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+const uint32_t ComponentStore::noSlot;
+
+void* ComponentStore::add( Entity entity, const MetaData& metaData )
+{
+  if ( entity > maxEntity ) throw InvalidEntityException{};
+
+  size_t index = metaData.getTypeIndex();
+  if ( index >= pools.size() ) pools.resize( index + 1 );
+  if ( !pools[index] ) pools[index].reset( new Pool{metaData} );
+
+  Pool& pool = *pools[index];
+  if ( entity >= pool.slots.size() )
+    pool.slots.resize( size_t{entity} + 1, noSlot );
+
+  uint32_t& slot = pool.slots[entity];
+  if ( slot != noSlot ) return pool.components.at( slot );
+
+  void* component = pool.components.emplaceBack();
+  pool.owners.push_back( entity );
+  slot = static_cast<uint32_t>( pool.owners.size() - 1 );
+
+  return component;
+}
+
+bool ComponentStore::remove( Entity entity,
+                             const MetaData& metaData ) noexcept
+{
+  Pool* pool = findPool( metaData );
+  if ( pool == nullptr || entity >= pool->slots.size() ||
+       pool->slots[entity] == noSlot )
+    return false;
+
+  uint32_t slot = pool->slots[entity];
+  Entity last = pool->owners.back();
+
+  pool->components.swapRemove( slot );
+  pool->owners[slot] = last;
+  pool->owners.pop_back();
+
+  pool->slots[last] = slot;
+  pool->slots[entity] = noSlot;
+
+  return true;
+}
+
+void ComponentStore::removeAll( Entity entity ) noexcept
+{
+  for ( const auto& pool : pools )
+  {
+    if ( pool ) remove( entity, pool->components.getMetaData() );
+  }
+}
+
+void* ComponentStore::get( Entity entity,
+                           const MetaData& metaData ) const noexcept
+{
+  Pool* pool = findPool( metaData );
+  if ( pool == nullptr || entity >= pool->slots.size() ||
+       pool->slots[entity] == noSlot )
+    return nullptr;
+
+  return pool->components.at( pool->slots[entity] );
+}
+
+size_t ComponentStore::size( const MetaData& metaData ) const noexcept
+{
+  Pool* pool = findPool( metaData );
+  return pool == nullptr ? 0 : pool->components.size();
+}
+
+const MetaArray*
+ComponentStore::getArray( const MetaData& metaData ) const noexcept
+{
+  Pool* pool = findPool( metaData );
+  return pool == nullptr ? nullptr : &pool->components;
+}
+
+const Entity*
+ComponentStore::getOwners( const MetaData& metaData ) const noexcept
+{
+  Pool* pool = findPool( metaData );
+  return pool == nullptr ? nullptr : pool->owners.data();
+}
+
+ComponentStore::Pool*
+ComponentStore::findPool( const MetaData& metaData ) const noexcept
+{
+  size_t index = metaData.getTypeIndex();
+  return index < pools.size() ? pools[index].get() : nullptr;
+}
@@ -0,0 +1,41 @@
+#include <tetra/meta/Dispatcher.hpp>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+void Dispatcher::setFallback( Fallback fallback )
+{
+  this->fallback = move( fallback );
+}
+
+bool Dispatcher::handles( const MetaData& metaData ) const noexcept
+{
+  size_t index = metaData.getTypeIndex();
+  return index < handlers.size() && handlers[index];
+}
+
+bool Dispatcher::dispatch( Variant& message ) const
+{
+  if ( !message.isEmpty() )
+  {
+    size_t index = message.getMetaData().getTypeIndex();
+    if ( index < handlers.size() && handlers[index] )
+    {
+      handlers[index]( message.getPayload() );
+      return true;
+    }
+  }
+
+  if ( fallback ) fallback( message );
+  return false;
+}
+
+void Dispatcher::addHandler( const MetaData& metaData,
+                             Handler handler )
+{
+  size_t index = metaData.getTypeIndex();
+  if ( index >= handlers.size() ) handlers.resize( index + 1 );
+
+  handlers[index] = move( handler );
+}
@@ -0,0 +1,125 @@
+#include <tetra/meta/EpochDomain.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+constexpr size_t EpochDomain::collectInterval;
+
+EpochDomain::Guard::Guard( Participant& participant ) noexcept
+  : participant{&participant}
+{
+  if ( participant.pinCount++ == 0 )
+  {
+    EpochDomain& domain = *participant.domain;
+    participant.pinnedEpoch.store(
+      domain.epoch.load( memory_order_relaxed ), memory_order_relaxed );
+
+    // the pin must be visible before any shared read is made
+    atomic_thread_fence( memory_order_seq_cst );
+  }
+}
+
+EpochDomain::Guard::~Guard()
+{
+  if ( participant != nullptr && --participant->pinCount == 0 )
+  {
+    participant->pinnedEpoch.store( 0, memory_order_release );
+  }
+}
+
+EpochDomain::Guard::Guard( Guard&& guard ) noexcept
+  : participant{guard.participant}
+{
+  guard.participant = nullptr;
+}
+
+EpochDomain::Participant::Participant( EpochDomain& domain )
+  : domain{&domain}
+{
+  lock_guard<mutex> lock{domain.participantsMutex};
+  domain.participants.push_back( this );
+}
+
+EpochDomain::Participant::~Participant()
+{
+  lock_guard<mutex> lock{domain->participantsMutex};
+  auto& participants = domain->participants;
+  participants.erase(
+    find( participants.begin(), participants.end(), this ) );
+
+  for ( auto& entry : retired )
+    domain->orphans.push_back( move( entry ) );
+}
+
+EpochDomain::Guard EpochDomain::Participant::pin() noexcept
+{
+  return Guard{*this};
+}
+
+bool EpochDomain::Participant::isPinned() const noexcept
+{
+  return pinCount != 0;
+}
+
+void EpochDomain::Participant::retire( Variant&& variant )
+{
+  retired.push_back(
+    {domain->epoch.load( memory_order_acquire ), move( variant )} );
+
+  if ( retired.size() % collectInterval == 0 ) collect();
+}
+
+size_t EpochDomain::Participant::collect()
+{
+  domain->tryAdvance();
+  return reclaim( retired, domain->getEpoch() );
+}
+
+size_t EpochDomain::Participant::getRetiredCount() const noexcept
+{
+  return retired.size();
+}
+
+size_t EpochDomain::getEpoch() const noexcept
+{
+  return epoch.load( memory_order_acquire );
+}
+
+bool EpochDomain::tryAdvance()
+{
+  lock_guard<mutex> lock{participantsMutex};
+
+  atomic_thread_fence( memory_order_seq_cst );
+  size_t current = epoch.load( memory_order_relaxed );
+  for ( Participant* participant : participants )
+  {
+    size_t pinned =
+      participant->pinnedEpoch.load( memory_order_relaxed );
+    if ( pinned != 0 && pinned != current ) return false;
+  }
+
+  atomic_thread_fence( memory_order_acquire );
+  epoch.store( current + 1, memory_order_release );
+
+  reclaim( orphans, current + 1 );
+  return true;
+}
+
+size_t EpochDomain::reclaim( vector<Participant::Retired>& retired,
+                             size_t epoch )
+{
+  // a participant pinned in epoch e keeps the epoch from passing
+  // e + 1, so Variants retired two epochs ago can no longer be read
+  auto readable =
+    partition( retired.begin(), retired.end(),
+               [epoch]( const Participant::Retired& entry ) {
+                 return entry.epoch + 2 > epoch;
+               } );
+
+  size_t count = size_t( retired.end() - readable );
+  retired.erase( readable, retired.end() );
+  return count;
+}
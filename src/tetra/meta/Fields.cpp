@@ -0,0 +1,147 @@
+#include <tetra/meta/Fields.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+void stringToJson( const void* field, Json::Value& value )
+{
+  value = *reinterpret_cast<const string*>( field );
+}
+
+bool stringFromJson( void* field, const Json::Value& value )
+{
+  if ( !value.isString() ) return false;
+
+  *reinterpret_cast<string*>( field ) = value.asString();
+  return true;
+}
+
+void stringToBinary( const void* field, string& out )
+{
+  const string& value = *reinterpret_cast<const string*>( field );
+  uint32_t length = static_cast<uint32_t>( value.size() );
+
+  out.append( reinterpret_cast<const char*>( &length ),
+              sizeof( length ) );
+  out.append( value );
+}
+
+bool stringFromBinary( void* field, const char*& begin,
+                       const char* end )
+{
+  uint32_t length;
+  if ( size_t( end - begin ) < sizeof( length ) ) return false;
+  memcpy( &length, begin, sizeof( length ) );
+
+  if ( size_t( end - begin ) - sizeof( length ) < length ) return false;
+  begin += sizeof( length );
+
+  reinterpret_cast<string*>( field )->assign( begin, length );
+  begin += length;
+  return true;
+}
+
+} /* namespace */
+
+const FieldCodec& FieldCodecFor<string>::get()
+{
+  static const FieldCodec codec{stringToJson, stringFromJson,
+                                stringToBinary, stringFromBinary};
+  return codec;
+}
+
+void TypeFields::add( Field field )
+{
+  fields.push_back( move( field ) );
+
+  // jsoncpp orders object members with strcmp
+  byName.push_back( fields.size() - 1 );
+  sort( byName.begin(), byName.end(), [this]( size_t lhs, size_t rhs ) {
+    return strcmp( fields[lhs].name.c_str(),
+                   fields[rhs].name.c_str() ) < 0;
+  } );
+}
+
+const vector<Field>& TypeFields::getFields() const noexcept
+{
+  return fields;
+}
+
+const Field* TypeFields::find( const string& name ) const noexcept
+{
+  for ( const Field& field : fields )
+  {
+    if ( field.name == name ) return &field;
+  }
+
+  return nullptr;
+}
+
+bool TypeFields::serialize( const void* obj, Json::Value& root ) const
+{
+  const char* base = reinterpret_cast<const char*>( obj );
+  for ( const Field& field : fields )
+  {
+    // the names live as long as the fields, so jsoncpp need not copy
+    // them
+    Json::Value& member = root[Json::StaticString{field.name.c_str()}];
+    field.codec->toJson( base + field.offset, member );
+  }
+
+  return true;
+}
+
+bool TypeFields::deserialize( void* obj, const Json::Value& root ) const
+{
+  if ( !root.isObject() ) return false;
+
+  char* base = reinterpret_cast<char*>( obj );
+  auto next = byName.begin();
+  for ( auto member = root.begin();
+        member != root.end() && next != byName.end(); ++member )
+  {
+    const char* name = member.memberName();
+
+    // both sides are sorted, skip fields the object doesn't have
+    int order = 1;
+    while ( next != byName.end() &&
+            ( order = strcmp( fields[*next].name.c_str(), name ) ) < 0 )
+      ++next;
+
+    if ( order == 0 )
+    {
+      const Field& field = fields[*next];
+      if ( !field.codec->fromJson( base + field.offset, *member ) )
+        return false;
+      ++next;
+    }
+  }
+
+  return true;
+}
+
+void TypeFields::writeBinary( const void* obj, string& out ) const
+{
+  const char* base = reinterpret_cast<const char*>( obj );
+  for ( const Field& field : fields )
+    field.codec->toBinary( base + field.offset, out );
+}
+
+bool TypeFields::readBinary( void* obj, const char*& begin,
+                             const char* end ) const
+{
+  char* base = reinterpret_cast<char*>( obj );
+  for ( const Field& field : fields )
+  {
+    if ( !field.codec->fromBinary( base + field.offset, begin, end ) )
+      return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,31 @@
+#include <tetra/meta/Memory.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+void* tetra::meta::alignedAllocate( size_t size, size_t alignment )
+{
+  if ( alignment < alignof( void* ) ) alignment = alignof( void* );
+
+  // over-allocate, and remember the original pointer just in front
+  // of the aligned block so that alignedFree can find it
+  void* raw = malloc( size + alignment + sizeof( void* ) );
+  if ( raw == nullptr ) throw bad_alloc{};
+
+  uintptr_t first =
+    reinterpret_cast<uintptr_t>( raw ) + sizeof( void* );
+  void* aligned = reinterpret_cast<void*>( alignUp( first, alignment ) );
+  reinterpret_cast<void**>( aligned )[-1] = raw;
+
+  return aligned;
+}
+
+void tetra::meta::alignedFree( void* memory ) noexcept
+{
+  if ( memory != nullptr ) free( reinterpret_cast<void**>( memory )[-1] );
+}
@@ -0,0 +1,156 @@
+#include <tetra/meta/MetaArray.hpp>
+
+#include <tetra/meta/Memory.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+// the array starts on a cache line, so ranges of whole cache lines
+// can be handed to different threads without false sharing
+const size_t cacheLineSize = 64;
+
+} /* namespace */
+
+MetaArray::MetaArray( const MetaData& metaData ) noexcept
+  : metaData{&metaData}
+{ }
+
+MetaArray::~MetaArray()
+{
+  clear();
+  alignedFree( elements );
+}
+
+MetaArray::MetaArray( MetaArray&& array ) noexcept
+  : metaData{array.metaData}
+  , elements{array.elements}
+  , count{array.count}
+  , allocated{array.allocated}
+{
+  array.elements = nullptr;
+  array.count = 0;
+  array.allocated = 0;
+}
+
+MetaArray& MetaArray::operator=( MetaArray&& array ) noexcept
+{
+  if ( this != &array )
+  {
+    this->~MetaArray();
+    new ( this ) MetaArray{std::move( array )};
+  }
+
+  return *this;
+}
+
+const MetaData& MetaArray::getMetaData() const noexcept
+{
+  return *metaData;
+}
+
+size_t MetaArray::size() const noexcept
+{
+  return count;
+}
+
+size_t MetaArray::capacity() const noexcept
+{
+  return allocated;
+}
+
+bool MetaArray::empty() const noexcept
+{
+  return count == 0;
+}
+
+void* MetaArray::data() const noexcept
+{
+  return elements;
+}
+
+void MetaArray::reserve( size_t capacity )
+{
+  if ( capacity > allocated ) reallocate( capacity );
+}
+
+void* MetaArray::emplaceBack()
+{
+  if ( count == allocated ) reserve( max<size_t>( 8, count * 2 ) );
+
+  void* element = at( count );
+  metaData->constructInstanceAt( element );
+  ++count;
+
+  return element;
+}
+
+void* MetaArray::relocateBack( void* src )
+{
+  if ( count == allocated ) reserve( max<size_t>( 8, count * 2 ) );
+
+  void* element = at( count );
+  metaData->relocateInstance( element, src );
+  ++count;
+
+  return element;
+}
+
+void MetaArray::swapRemove( size_t index ) noexcept
+{
+  size_t last = count - 1;
+  metaData->destroyInstanceAt( at( index ) );
+  if ( index != last )
+    metaData->relocateInstance( at( index ), at( last ) );
+
+  --count;
+}
+
+void MetaArray::popBack() noexcept
+{
+  metaData->destroyInstanceAt( at( --count ) );
+}
+
+void MetaArray::clear() noexcept
+{
+  while ( count != 0 ) popBack();
+}
+
+void MetaArray::shrinkToFit()
+{
+  if ( allocated != count ) reallocate( count );
+}
+
+void MetaArray::reallocate( size_t capacity )
+{
+  char* replacement = nullptr;
+  if ( capacity != 0 )
+  {
+    replacement = reinterpret_cast<char*>( alignedAllocate(
+      capacity * metaData->getSize(),
+      max( metaData->getAlignment(), cacheLineSize ) ) );
+  }
+
+  if ( metaData->isTriviallyCopyable() && count != 0 )
+  {
+    memcpy( replacement, elements, count * metaData->getSize() );
+  }
+  else
+  {
+    for ( size_t i = 0; i < count; ++i )
+    {
+      metaData->relocateInstance(
+        replacement + i * metaData->getSize(), at( i ) );
+    }
+  }
+
+  alignedFree( elements );
+  elements = replacement;
+  allocated = capacity;
+}
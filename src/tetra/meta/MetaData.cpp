@@ -1,13 +1,27 @@
 #include "tetra/meta/MetaData.hpp"
 
+#include <atomic>
 #include <iostream>
 
+using namespace std;
 using namespace tetra;
 using namespace tetra::meta;
 
+namespace
+{
+
+atomic<size_t> typeCount{0};
+
+} /* namespace */
+
 MetaData::MetaData( MetaConstructor constructor,
-                    MetaDestructor destructor, MetaCopy copy )
-  : typeCopy{copy}
+                    MetaDestructor destructor, MetaCopy copy,
+                    const Layout& layout,
+                    const Comparison& comparison )
+  : typeIndex{typeCount++}
+  , layout( layout )
+  , comparison( comparison )
+  , typeCopy{copy}
   , typeConstructor{constructor}
   , typeDestructor{destructor}
 {
@@ -15,14 +29,21 @@ MetaData::MetaData( MetaConstructor constructor,
 
 MetaData::MetaData( MetaConstructor constructor,
                     MetaDestructor destructor, MetaCopy copy,
+                    const Layout& layout,
+                    const Comparison& comparison,
                     MetaSerializer serializer,
-                    MetaDeserializer deserializer )
-  : supportsSerialization{true}
+                    MetaDeserializer deserializer,
+                    const TypeFields* fields )
+  : typeIndex{typeCount++}
+  , layout( layout )
+  , comparison( comparison )
+  , supportsSerialization{true}
   , typeCopy{copy}
   , typeConstructor{constructor}
   , typeDestructor{destructor}
   , typeSerializer{serializer}
   , typeDeserializer{deserializer}
+  , typeFields{fields}
 {
 }
 
@@ -31,6 +52,16 @@ bool MetaData::operator==( const MetaData& metaData ) const noexcept
   return this == &metaData;
 }
 
+size_t MetaData::getTypeIndex() const noexcept
+{
+  return this->typeIndex;
+}
+
+size_t MetaData::getTypeCount() noexcept
+{
+  return typeCount;
+}
+
 void* MetaData::constructInstance() const
 {
   return this->typeConstructor();
@@ -41,23 +72,93 @@ void MetaData::destroyInstance( void* obj ) const noexcept
   this->typeDestructor( obj );
 }
 
-void MetaData::copyInstance( void* lhs, void* rhs ) const noexcept
+void MetaData::copyInstance( void* lhs, const void* rhs ) const
 {
   this->typeCopy( lhs, rhs );
 }
 
+size_t MetaData::getSize() const noexcept
+{
+  return this->layout.size;
+}
+
+size_t MetaData::getAlignment() const noexcept
+{
+  return this->layout.alignment;
+}
+
+bool MetaData::isTriviallyCopyable() const noexcept
+{
+  return this->layout.triviallyCopyable;
+}
+
+void MetaData::constructInstanceAt( void* memory ) const
+{
+  this->layout.constructAt( memory );
+}
+
+void MetaData::destroyInstanceAt( void* obj ) const noexcept
+{
+  this->layout.destroyAt( obj );
+}
+
+void MetaData::relocateInstance( void* dest, void* src ) const
+{
+  this->layout.relocate( dest, src );
+}
+
+void MetaData::deallocateInstance( void* memory ) const noexcept
+{
+  this->layout.deallocate( memory );
+}
+
 bool MetaData::canSerialize() const noexcept
 {
   return this->supportsSerialization;
 }
 
+const TypeFields* MetaData::getFields() const noexcept
+{
+  return this->typeFields;
+}
+
+bool MetaData::canHash() const noexcept
+{
+  return this->comparison.hash != nullptr;
+}
+
+bool MetaData::canCompareEqual() const noexcept
+{
+  return this->comparison.equal != nullptr;
+}
+
+bool MetaData::canCompareLess() const noexcept
+{
+  return this->comparison.less != nullptr;
+}
+
+size_t MetaData::hashInstance( const void* obj ) const
+{
+  return this->comparison.hash( obj );
+}
+
+bool MetaData::equalInstances( const void* lhs, const void* rhs ) const
+{
+  return this->comparison.equal( lhs, rhs );
+}
+
+bool MetaData::lessInstance( const void* lhs, const void* rhs ) const
+{
+  return this->comparison.less( lhs, rhs );
+}
+
 bool MetaData::serializeInstance( void* obj, Json::Value& root ) const
 {
   return this->typeSerializer( obj, root );
 }
 
 bool MetaData::deserializeInstance( void* obj,
-                                    Json::Value& root ) const
+                                    const Json::Value& root ) const
 {
   return this->typeDeserializer( obj, root );
 }
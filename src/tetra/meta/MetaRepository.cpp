@@ -38,43 +38,173 @@ MetaRepository::MetaRepository()
 void MetaRepository::serialize( const Variant& obj,
                                 Json::Value& root ) const
 {
-  root["type"] = getTypeName( obj.getMetaData() );
+  TypeCache cache{};
+  serialize( obj, root, cache );
+}
+
+Variant MetaRepository::deserialize( const Json::Value& root ) const
+{
+  TypeCache cache{};
+  return deserialize( root, cache );
+}
+
+vector<Variant>
+MetaRepository::deserializeMany( const Json::Value& array ) const
+{
+  vector<Variant> variants;
+  variants.reserve( array.size() );
+  deserializeMany( array, back_inserter( variants ) );
+
+  return variants;
+}
+
+void MetaRepository::serialize( const Variant& obj, Json::Value& root,
+                                TypeCache& cache ) const
+{
+  if ( cache.metaData != &obj.getMetaData() )
+  {
+    cache.typeName = &getTypeName( obj.getMetaData() );
+    cache.metaData = &obj.getMetaData();
+  }
+  root["type"] = *cache.typeName;
 
   Json::Value object{};
   if ( obj.serialize( object ) ) // serialize
     root["object"] = object;     // only write on success
 }
 
-Variant MetaRepository::deserialize( Json::Value& root ) const
+Variant MetaRepository::deserialize( const Json::Value& root,
+                                     TypeCache& cache ) const
 {
-  string typeName = root.get( "type", "" ).asString();
-  const MetaData& typeMetaData = getMetaData( typeName );
+  Variant var{resolveType( root, cache )};
+  var.deserialize( root["object"] );
 
-  Json::Value object = root.get( "object", 0 );
+  return var;
+}
 
-  Variant var{ typeMetaData };
-  var.deserialize( object );
+void MetaRepository::deserializeInto( Variant& target,
+                                      const Json::Value& root ) const
+{
+  // seed the cache with the target's type, so that receiving the
+  // same type again needs neither a name lookup nor an allocation
+  TypeCache cache{};
+  if ( !target.isEmpty() )
+  {
+    auto iter = metaToNameMap.find( &target.getMetaData() );
+    if ( iter != metaToNameMap.end() )
+    {
+      cache.metaData = iter->first;
+      cache.typeName = &iter->second;
+    }
+  }
+
+  const MetaData& typeMetaData = resolveType( root, cache );
+  if ( !target.holds( typeMetaData ) )
+    target = Variant{typeMetaData};
+
+  target.deserialize( root["object"] );
+}
 
-  return var;
+bool MetaRepository::tryDeserialize( const Json::Value& root,
+                                     Variant& result ) const
+{
+  // indexing a Json::Value which is not an object throws, so the
+  // shape is checked before anything is looked up
+  if ( !root.isObject() || !root["type"].isString() ) return false;
+
+  TypeCache cache{};
+  const MetaData* typeMetaData = findType( root, cache );
+  if ( typeMetaData == nullptr ) return false;
+
+  Variant var{*typeMetaData};
+  if ( typeMetaData->canSerialize() )
+  {
+    const Json::Value& object = root["object"];
+    if ( !object.isObject() ) return false;
+
+    // jsoncpp reports values which do not convert by throwing
+    try
+    {
+      if ( !var.deserialize( object ) ) return false;
+    }
+    catch ( const runtime_error& )
+    {
+      return false;
+    }
+  }
+
+  result = std::move( var );
+  return true;
+}
+
+const MetaData&
+MetaRepository::resolveType( const Json::Value& root,
+                             TypeCache& cache ) const
+{
+  const MetaData* typeMetaData = findType( root, cache );
+  if ( typeMetaData == nullptr )
+  {
+    const Json::Value& type =
+      root.isObject() ? root["type"] : Json::Value::null;
+    throw TypeNotRegisteredException{type.isString() ? type.asString()
+                                                     : ""};
+  }
+
+  return *typeMetaData;
+}
+
+const MetaData* MetaRepository::findType( const Json::Value& root,
+                                          TypeCache& cache ) const
+{
+  const Json::Value& type =
+    root.isObject() ? root["type"] : Json::Value::null;
+  const char* typeName = type.isString() ? type.asCString() : "";
+
+  // comparing against the cached name does not allocate
+  if ( cache.typeName == nullptr || *cache.typeName != typeName )
+  {
+    auto iter = nameToMetaMap.find( typeName );
+    if ( iter == nameToMetaMap.end() ) return nullptr;
+
+    cache.typeName = &iter->first;
+    cache.metaData = iter->second;
+  }
+
+  return cache.metaData;
 }
 
 const MetaData&
 MetaRepository::getMetaData( const string& typeName ) const
 {
-  auto iter = nameToMetaMap.find( typeName );
-  if ( iter == nameToMetaMap.end() )
+  const MetaData* metaData = findMetaData( typeName );
+  if ( metaData == nullptr )
     throw TypeNotRegisteredException{typeName};
 
-  return *( iter->second );
+  return *metaData;
 }
 
 const string& MetaRepository::getTypeName( const MetaData& metaData ) const
 {
-  auto iter = metaToNameMap.find(&metaData);
-  if ( iter == metaToNameMap.end() )
+  const string* typeName = findTypeName( metaData );
+  if ( typeName == nullptr )
     throw TypeNotRegisteredException{};
 
-  return iter->second;
+  return *typeName;
+}
+
+const MetaData*
+MetaRepository::findMetaData( const string& typeName ) const noexcept
+{
+  auto iter = nameToMetaMap.find( typeName );
+  return iter == nameToMetaMap.end() ? nullptr : iter->second;
+}
+
+const string*
+MetaRepository::findTypeName( const MetaData& metaData ) const
+  noexcept
+{
+  auto iter = metaToNameMap.find( &metaData );
+  return iter == metaToNameMap.end() ? nullptr : &iter->second;
 }
 
 Variant MetaRepository::createInstance( const string& typeName ) const
@@ -0,0 +1,204 @@
+#include <tetra/meta/ParallelLoader.hpp>
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <cctype>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+// Chunks smaller than this cost more to schedule than to parse.
+const size_t minimumChunkSize = 64 * 1024;
+
+// More chunks than threads lets fast threads pick up the slack.
+const size_t chunksPerThread = 8;
+
+struct Chunk
+{
+  const char* begin;
+  const char* end;
+};
+
+/**
+ * Splits [begin, end) into chunks of roughly chunkSize bytes, each
+ * chunk ends just after a newline (or at the end of the input).
+ **/
+vector<Chunk> splitLines( const char* begin, const char* end,
+                          size_t chunkSize )
+{
+  vector<Chunk> chunks;
+  while ( begin != end )
+  {
+    const char* split = begin + min<size_t>( chunkSize, end - begin );
+    split = find( split, end, '\n' );
+    if ( split != end ) ++split;
+
+    chunks.push_back( {begin, split} );
+    begin = split;
+  }
+
+  return chunks;
+}
+
+/**
+ * Deserializes each non-empty line of the chunk and appends the
+ * Variants to output.
+ **/
+void loadChunk( const MetaRepository& repository, const char* input,
+                const Chunk& chunk, vector<Variant>& output )
+{
+  Json::Reader reader{};
+  Json::Value root{};
+
+  const char* line = chunk.begin;
+  while ( line != chunk.end )
+  {
+    const char* lineEnd = find( line, chunk.end, '\n' );
+
+    if ( find_if( line, lineEnd, []( char c ) {
+           return !isspace( static_cast<unsigned char>( c ) );
+         } ) != lineEnd )
+    {
+      if ( !reader.parse( line, lineEnd, root, false ) )
+      {
+        // only count lines on the failure path
+        size_t lineNumber = 1 + count( input, line, '\n' );
+        throw ParseException{lineNumber,
+                             reader.getFormattedErrorMessages()};
+      }
+
+      output.push_back( repository.deserialize( root ) );
+    }
+
+    line = lineEnd == chunk.end ? lineEnd : lineEnd + 1;
+  }
+}
+
+} /* namespace */
+
+ParseException::ParseException( size_t lineNumber,
+                                const string& errors )
+  : runtime_error{"Unable to parse line " + to_string( lineNumber ) +
+                  ": " + errors}
+  , lineNumber{lineNumber}
+{ }
+
+size_t ParseException::getLineNumber() const noexcept
+{
+  return lineNumber;
+}
+
+ParallelLoader::ParallelLoader( const MetaRepository& repository,
+                                unsigned threadCount )
+  : repository( repository )
+  , threadCount{max( threadCount, 1u )}
+{ }
+
+vector<Variant> ParallelLoader::load( const string& ndjson,
+                                      Ordering ordering ) const
+{
+  return load( ndjson.data(), ndjson.data() + ndjson.size(),
+               ordering );
+}
+
+vector<Variant> ParallelLoader::load( const char* begin,
+                                      const char* end,
+                                      Ordering ordering ) const
+{
+  vector<Variant> results;
+  if ( threadCount == 1 )
+  {
+    loadChunk( repository, begin, {begin, end}, results );
+    return results;
+  }
+
+  size_t chunkSize =
+    max( minimumChunkSize,
+         static_cast<size_t>( end - begin ) /
+           ( threadCount * chunksPerThread ) );
+  const vector<Chunk> chunks = splitLines( begin, end, chunkSize );
+
+  vector<vector<Variant>> chunkResults(
+    ordering == Ordering::InputOrder ? chunks.size() : 0 );
+
+  atomic<size_t> nextChunk{0};
+  atomic<bool> failed{false};
+  exception_ptr failure{};
+  mutex resultsMutex{};
+
+  auto worker = [&]() {
+    vector<Variant> local;
+    try
+    {
+      for ( size_t i = nextChunk++; i < chunks.size() && !failed;
+            i = nextChunk++ )
+      {
+        vector<Variant>& output =
+          ordering == Ordering::InputOrder ? chunkResults[i] : local;
+        loadChunk( repository, begin, chunks[i], output );
+
+        if ( ordering == Ordering::Unordered )
+        {
+          lock_guard<mutex> lock{resultsMutex};
+          move( local.begin(), local.end(),
+                back_inserter( results ) );
+          local.clear();
+        }
+      }
+    }
+    catch ( ... )
+    {
+      lock_guard<mutex> lock{resultsMutex};
+      if ( !failed.exchange( true ) ) failure = current_exception();
+    }
+  };
+
+  unsigned workerCount =
+    min<size_t>( threadCount, chunks.size() );
+  vector<thread> workers;
+  workers.reserve( workerCount );
+  try
+  {
+    for ( unsigned i = 1; i < workerCount; ++i )
+      workers.emplace_back( worker );
+  }
+  catch ( ... )
+  {
+    // joinable threads must not be destroyed, stop and join the ones
+    // which did start before passing the failure on
+    failed = true;
+    for ( auto& thread : workers ) thread.join();
+    throw;
+  }
+
+  worker(); // the calling thread works too
+  for ( auto& thread : workers ) thread.join();
+
+  if ( failure ) rethrow_exception( failure );
+
+  if ( ordering == Ordering::InputOrder )
+  {
+    size_t total = 0;
+    for ( const auto& chunk : chunkResults ) total += chunk.size();
+
+    results.reserve( total );
+    for ( auto& chunk : chunkResults )
+      move( chunk.begin(), chunk.end(), back_inserter( results ) );
+  }
+
+  return results;
+}
+
+unsigned ParallelLoader::getThreadCount() const noexcept
+{
+  return threadCount;
+}
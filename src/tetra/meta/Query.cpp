@@ -0,0 +1,59 @@
+#include <tetra/meta/Query.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+bool byTypeIndex( const MetaData* lhs, const MetaData* rhs )
+{
+  return lhs->getTypeIndex() < rhs->getTypeIndex();
+}
+
+} /* namespace */
+
+Query::Query( vector<const MetaData*> types )
+  : types( move( types ) )
+{
+  sort( this->types.begin(), this->types.end(), byTypeIndex );
+
+  // includes counts repeats, so a type listed twice would never match
+  this->types.erase( unique( this->types.begin(), this->types.end() ),
+                     this->types.end() );
+}
+
+const vector<const MetaData*>& Query::getTypes() const noexcept
+{
+  return types;
+}
+
+const vector<const Archetype*>& Query::getArchetypes() const noexcept
+{
+  return archetypes;
+}
+
+bool Query::matches( const Archetype& archetype ) const noexcept
+{
+  // both type lists are sorted by type index
+  return includes( archetype.getTypes().begin(),
+                   archetype.getTypes().end(), types.begin(),
+                   types.end(), byTypeIndex );
+}
+
+size_t Query::size() const noexcept
+{
+  size_t total = 0;
+  for ( const Archetype* archetype : archetypes )
+    total += archetype->size();
+
+  return total;
+}
+
+void Query::consider( const Archetype& archetype )
+{
+  if ( matches( archetype ) ) archetypes.push_back( &archetype );
+}
@@ -0,0 +1,139 @@
+#include <tetra/meta/SerializationCache.hpp>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+SerializationCache::SerializationCache(
+  const MetaRepository& repository )
+  : repository{&repository}
+{
+}
+
+const Json::Value& SerializationCache::serialize( Variant& variant )
+{
+  Entry& entry = lookup( variant );
+  if ( entry.hasNode )
+  {
+    ++hits;
+  }
+  else
+  {
+    ++misses;
+    makeNode( variant, entry );
+  }
+
+  return entry.node;
+}
+
+const string& SerializationCache::serializeText( Variant& variant )
+{
+  Entry& entry = lookup( variant );
+  if ( entry.hasText )
+  {
+    ++hits;
+    return entry.text;
+  }
+
+  ++misses;
+  if ( !entry.hasNode ) makeNode( variant, entry );
+
+  Json::FastWriter writer{};
+  entry.text = writer.write( entry.node );
+  entry.hasText = true;
+
+  return entry.text;
+}
+
+bool SerializationCache::writeBinary( Variant& variant, string& out )
+{
+  Entry& entry = lookup( variant );
+  if ( !entry.hasBinary )
+  {
+    ++misses;
+    entry.binary.clear();
+    if ( !variant.writeBinary( entry.binary ) ) return false;
+    entry.hasBinary = true;
+  }
+  else
+  {
+    ++hits;
+  }
+
+  out.append( entry.binary );
+  return true;
+}
+
+size_t SerializationCache::finishSnapshot()
+{
+  size_t dropped = 0;
+  for ( auto iter = entries.begin(); iter != entries.end(); )
+  {
+    if ( iter->second.snapshot != snapshot )
+    {
+      iter = entries.erase( iter );
+      ++dropped;
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+
+  ++snapshot;
+  return dropped;
+}
+
+void SerializationCache::forget( const Variant& variant ) noexcept
+{
+  entries.erase( &variant );
+}
+
+void SerializationCache::clear() noexcept
+{
+  entries.clear();
+}
+
+size_t SerializationCache::size() const noexcept
+{
+  return entries.size();
+}
+
+size_t SerializationCache::getHitCount() const noexcept
+{
+  return hits;
+}
+
+size_t SerializationCache::getMissCount() const noexcept
+{
+  return misses;
+}
+
+SerializationCache::Entry& SerializationCache::lookup( Variant& variant )
+{
+  Entry& entry = entries[&variant];
+  entry.snapshot = snapshot;
+
+  const MetaData* metaData =
+    variant.isEmpty() ? nullptr : &variant.getMetaData();
+  if ( variant.isDirty() || entry.metaData != metaData ||
+       entry.payload != variant.getConstPayload() )
+  {
+    entry.metaData = metaData;
+    entry.payload = variant.getConstPayload();
+    entry.hasNode = false;
+    entry.hasText = false;
+    entry.hasBinary = false;
+    variant.markClean();
+  }
+
+  return entry;
+}
+
+void SerializationCache::makeNode( const Variant& variant,
+                                   Entry& entry ) const
+{
+  entry.node = Json::Value{};
+  repository->serialize( variant, entry.node );
+  entry.hasNode = true;
+}
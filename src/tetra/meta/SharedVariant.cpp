@@ -0,0 +1,129 @@
+#include <tetra/meta/SharedVariant.hpp>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+SharedVariant::SharedVariant( Variant&& variant )
+  : control{new Control{}}
+{
+  control->references.store( 1, memory_order_relaxed );
+  control->variant = move( variant );
+}
+
+SharedVariant::~SharedVariant()
+{
+  decrement();
+}
+
+SharedVariant::SharedVariant( const SharedVariant& shared ) noexcept
+  : control{shared.control}
+{
+  if ( control != nullptr )
+    control->references.fetch_add( 1, memory_order_relaxed );
+}
+
+SharedVariant& SharedVariant::operator=(
+  const SharedVariant& shared ) noexcept
+{
+  if ( shared.control != nullptr )
+    shared.control->references.fetch_add( 1, memory_order_relaxed );
+
+  decrement();
+  control = shared.control;
+
+  return *this;
+}
+
+SharedVariant::SharedVariant( SharedVariant&& shared ) noexcept
+  : control{shared.control}
+{
+  shared.control = nullptr;
+}
+
+SharedVariant& SharedVariant::operator=( SharedVariant&& shared ) noexcept
+{
+  if ( this != &shared )
+  {
+    decrement();
+    control = shared.control;
+    shared.control = nullptr;
+  }
+
+  return *this;
+}
+
+bool SharedVariant::isEmpty() const noexcept
+{
+  return control == nullptr;
+}
+
+size_t SharedVariant::getUseCount() const noexcept
+{
+  if ( control == nullptr ) return 0;
+
+  return control->references.load( memory_order_relaxed );
+}
+
+bool SharedVariant::holds( const MetaData& metaData ) const noexcept
+{
+  return control != nullptr && control->variant.holds( metaData );
+}
+
+const MetaData* SharedVariant::getMetaData() const noexcept
+{
+  if ( control == nullptr || control->variant.isEmpty() ) return nullptr;
+
+  return &control->variant.getMetaData();
+}
+
+const void* SharedVariant::getConstPayload() const noexcept
+{
+  return control == nullptr ? nullptr
+                            : control->variant.getConstPayload();
+}
+
+Variant& SharedVariant::getMutableVariant()
+{
+  if ( control == nullptr )
+  {
+    throw TypeCastException{};
+  }
+
+  unshare();
+  return control->variant;
+}
+
+Variant SharedVariant::release()
+{
+  Variant variant{};
+  if ( control != nullptr )
+  {
+    unshare();
+    variant = move( control->variant );
+    decrement();
+    control = nullptr;
+  }
+
+  return variant;
+}
+
+void SharedVariant::unshare()
+{
+  // only this handle can make the count grow from 1, so a count of 1
+  // means the payload is ours
+  if ( control->references.load( memory_order_acquire ) == 1 ) return;
+
+  SharedVariant copy{Variant{}};
+  copy.control->variant.copy( control->variant );
+  swap( control, copy.control );
+}
+
+void SharedVariant::decrement() noexcept
+{
+  if ( control != nullptr &&
+       control->references.fetch_sub( 1, memory_order_acq_rel ) == 1 )
+  {
+    delete control;
+  }
+}
@@ -0,0 +1,73 @@
+#include <tetra/meta/SystemSchedule.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+bool overlaps( const vector<const MetaData*>& lhs,
+               const vector<const MetaData*>& rhs ) noexcept
+{
+  for ( const MetaData* type : lhs )
+    if ( find( rhs.begin(), rhs.end(), type ) != rhs.end() )
+      return true;
+
+  return false;
+}
+
+} /* namespace */
+
+bool Access::conflictsWith( const Access& access ) const noexcept
+{
+  return overlaps( writes, access.writes ) ||
+         overlaps( writes, access.reads ) ||
+         overlaps( reads, access.writes );
+}
+
+void SystemSchedule::add( string name, Access access, System system )
+{
+  size_t phase = 0;
+  for ( size_t earlier = 0; earlier < phases.size(); ++earlier )
+  {
+    for ( size_t index : phases[earlier] )
+      if ( entries[index].access.conflictsWith( access ) )
+        phase = earlier + 1;
+  }
+
+  entries.push_back( {move( name ), move( access ), move( system )} );
+  if ( phase == phases.size() ) phases.emplace_back();
+  phases[phase].push_back( entries.size() - 1 );
+}
+
+size_t SystemSchedule::getPhaseCount() const noexcept
+{
+  return phases.size();
+}
+
+vector<string> SystemSchedule::getPhase( size_t phase ) const
+{
+  vector<string> names;
+  for ( size_t index : phases.at( phase ) )
+    names.push_back( entries[index].name );
+
+  return names;
+}
+
+void SystemSchedule::run( TaskScheduler& scheduler ) const
+{
+  for ( const auto& phase : phases )
+  {
+    vector<TaskScheduler::Task> tasks;
+    for ( size_t index : phase )
+    {
+      const System& system = entries[index].system;
+      tasks.push_back( [&system, &scheduler]() { system( scheduler ); } );
+    }
+
+    scheduler.run( tasks );
+  }
+}
@@ -0,0 +1,192 @@
+#include <tetra/meta/TaskScheduler.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+// identifies the worker slot of the current thread
+thread_local const TaskScheduler* currentScheduler{nullptr};
+thread_local size_t currentWorkerSlot{0};
+
+} /* namespace */
+
+TaskScheduler::TaskScheduler( unsigned threadCount )
+{
+  threadCount = max( threadCount, 1u );
+  for ( unsigned i = 0; i < threadCount; ++i )
+    workers.emplace_back( new Worker{} );
+
+  threads.reserve( threadCount - 1 );
+  try
+  {
+    for ( unsigned slot = 1; slot < threadCount; ++slot )
+    {
+      threads.emplace_back( [this, slot]() {
+        currentScheduler = this;
+        currentWorkerSlot = slot;
+        workerLoop( slot );
+      } );
+    }
+  }
+  catch ( ... )
+  {
+    // joinable threads must not be destroyed
+    stop();
+    throw;
+  }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  stop();
+}
+
+unsigned TaskScheduler::getThreadCount() const noexcept
+{
+  return static_cast<unsigned>( workers.size() );
+}
+
+void TaskScheduler::parallelFor( size_t begin, size_t end,
+                                 size_t grain, const RangeBody& body )
+{
+  if ( begin >= end ) return;
+
+  Batch batch{};
+  batch.pending = 1;
+
+  size_t slot = currentSlot();
+  execute( slot, {&body, begin, end, max<size_t>( grain, 1 ), &batch} );
+  wait( slot, batch );
+}
+
+void TaskScheduler::run( const vector<Task>& tasks )
+{
+  parallelFor( 0, tasks.size(), 1,
+               [&tasks]( size_t first, size_t last ) {
+                 for ( size_t i = first; i < last; ++i ) tasks[i]();
+               } );
+}
+
+size_t TaskScheduler::currentSlot() const noexcept
+{
+  return currentScheduler == this ? currentWorkerSlot : 0;
+}
+
+void TaskScheduler::push( size_t slot, const Job& job )
+{
+  {
+    lock_guard<mutex> lock{workers[slot]->mutex};
+    workers[slot]->jobs.push_back( job );
+  }
+
+  {
+    // taking the lock orders this with a worker going to sleep
+    lock_guard<mutex> lock{sleepMutex};
+    ++queuedJobs;
+  }
+  wakeUp.notify_one();
+}
+
+bool TaskScheduler::tryRunOne( size_t slot )
+{
+  Job job{};
+  bool found = false;
+
+  {
+    // newest job of our own first
+    Worker& own = *workers[slot];
+    lock_guard<mutex> lock{own.mutex};
+    if ( !own.jobs.empty() )
+    {
+      job = own.jobs.back();
+      own.jobs.pop_back();
+      found = true;
+    }
+  }
+
+  // otherwise steal the oldest, largest, job of another thread
+  for ( size_t i = 1; !found && i < workers.size(); ++i )
+  {
+    Worker& victim = *workers[( slot + i ) % workers.size()];
+    lock_guard<mutex> lock{victim.mutex};
+    if ( !victim.jobs.empty() )
+    {
+      job = victim.jobs.front();
+      victim.jobs.pop_front();
+      found = true;
+    }
+  }
+
+  if ( !found ) return false;
+
+  --queuedJobs;
+  execute( slot, job );
+  return true;
+}
+
+void TaskScheduler::execute( size_t slot, Job job )
+{
+  try
+  {
+    // keep the first half, offer the second half for stealing
+    size_t pieces = ( job.end - job.begin + job.grain - 1 ) / job.grain;
+    while ( pieces > 1 )
+    {
+      size_t mid = job.begin + ( pieces / 2 ) * job.grain;
+
+      ++job.batch->pending;
+      push( slot, {job.body, mid, job.end, job.grain, job.batch} );
+
+      job.end = mid;
+      pieces = ( job.end - job.begin + job.grain - 1 ) / job.grain;
+    }
+
+    ( *job.body )( job.begin, job.end );
+  }
+  catch ( ... )
+  {
+    lock_guard<mutex> lock{job.batch->errorMutex};
+    if ( !job.batch->error ) job.batch->error = current_exception();
+  }
+
+  --job.batch->pending;
+}
+
+void TaskScheduler::wait( size_t slot, Batch& batch )
+{
+  while ( batch.pending != 0 )
+  {
+    if ( !tryRunOne( slot ) ) this_thread::yield();
+  }
+
+  if ( batch.error ) rethrow_exception( batch.error );
+}
+
+void TaskScheduler::workerLoop( size_t slot )
+{
+  for ( ;; )
+  {
+    if ( tryRunOne( slot ) ) continue;
+
+    unique_lock<mutex> lock{sleepMutex};
+    wakeUp.wait( lock,
+                 [this]() { return stopping || queuedJobs != 0; } );
+    if ( stopping ) return;
+  }
+}
+
+void TaskScheduler::stop() noexcept
+{
+  {
+    lock_guard<mutex> lock{sleepMutex};
+    stopping = true;
+  }
+  wakeUp.notify_all();
+
+  for ( auto& thread : threads ) thread.join();
+}
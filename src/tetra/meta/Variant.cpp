@@ -1,22 +1,22 @@
 #include <tetra/meta/Variant.hpp>
+#include <tetra/meta/Fields.hpp>
 
 using namespace tetra;
 using namespace tetra::meta;
 
+const std::uintptr_t Variant::arenaTag;
+const std::uintptr_t Variant::dirtyTag;
+
 Variant::Variant( const MetaData& metaData ) noexcept
   : metaData{&metaData},
     pObj{metaData.constructInstance()}
 {
+  markDirty();
 }
 
 Variant::~Variant()
 {
-  if ( pObj != nullptr && metaData != nullptr )
-  {
-    metaData->destroyInstance( pObj );
-    pObj = nullptr;
-    metaData = nullptr;
-  }
+  reset();
 }
 
 Variant::Variant( Variant&& variant ) noexcept
@@ -25,14 +25,15 @@ Variant::Variant( Variant&& variant ) noexcept
 {
   variant.metaData = nullptr;
   variant.pObj = nullptr;
+
+  // whatever was serialized from this Variant described another
+  // payload
+  markDirty();
 }
 
 Variant& Variant::operator=( Variant&& variant ) noexcept
 {
-  if ( pObj != nullptr && metaData != nullptr )
-  {
-    metaData->destroyInstance( pObj );
-  }
+  reset();
 
   // in-place new to call the move c'tor
   new ( this ) Variant{std::move( variant )};
@@ -40,22 +41,32 @@ Variant& Variant::operator=( Variant&& variant ) noexcept
   return *this;
 }
 
-void Variant::copy( const Variant& variant ) noexcept
+void Variant::copy( const Variant& variant )
 {
-  if ( pObj != nullptr && metaData != nullptr )
+  if ( variant.metaData == nullptr || variant.pObj == nullptr )
   {
-    metaData->destroyInstance( pObj );
-    pObj = nullptr;
-    metaData = nullptr;
+    reset();
+    return;
   }
 
-  if ( variant.metaData != nullptr && variant.pObj != nullptr )
+  // copy into a new instance first, so a throwing copy leaves this
+  // Variant unchanged
+  const MetaData& type = *variant.metaData;
+  void* copied = type.constructInstance();
+  try
   {
-    metaData = variant.metaData;
-    pObj = metaData->constructInstance();
-
-    metaData->copyInstance( pObj, variant.pObj );
+    type.copyInstance( copied, variant.payload() );
   }
+  catch ( ... )
+  {
+    type.destroyInstance( copied );
+    throw;
+  }
+
+  reset();
+  metaData = &type;
+  pObj = copied;
+  markDirty();
 }
 
 bool Variant::serialize( Json::Value& root ) const
@@ -63,18 +74,98 @@ bool Variant::serialize( Json::Value& root ) const
   if (!getMetaData().canSerialize())
     return false;
 
-  return getMetaData().serializeInstance( this->pObj, root );
+  return getMetaData().serializeInstance( payload(), root );
 }
 
-bool Variant::deserialize( Json::Value& root )
+bool Variant::deserialize( const Json::Value& root )
 {
   if (!getMetaData().canSerialize())
     return false;
 
-  return getMetaData().deserializeInstance( this->pObj, root );
+  markDirty();
+  return getMetaData().deserializeInstance( payload(), root );
+}
+
+bool Variant::writeBinary( std::string& out ) const
+{
+  if ( isEmpty() || getMetaData().getFields() == nullptr )
+    return false;
+
+  getMetaData().getFields()->writeBinary( payload(), out );
+  return true;
+}
+
+bool Variant::readBinary( const char*& begin, const char* end )
+{
+  if ( isEmpty() || getMetaData().getFields() == nullptr )
+    return false;
+
+  markDirty();
+  return getMetaData().getFields()->readBinary( payload(), begin,
+                                                end );
 }
 
 const MetaData& Variant::getMetaData() const noexcept
 {
   return *metaData;
 }
+
+bool Variant::isEmpty() const noexcept
+{
+  return pObj == nullptr;
+}
+
+bool Variant::holds( const MetaData& metaData ) const noexcept
+{
+  return this->metaData == &metaData;
+}
+
+std::size_t Variant::hash() const
+{
+  if ( isEmpty() ) return 0;
+  if ( !metaData->canHash() ) throw UnsupportedOperationException{};
+
+  // spreads the small type indices over the whole word
+  const std::size_t typeMix =
+    static_cast<std::size_t>( 0x9E3779B97F4A7C15ull );
+
+  return metaData->hashInstance( payload() ) ^
+         ( metaData->getTypeIndex() + 1 ) * typeMix;
+}
+
+bool Variant::operator==( const Variant& variant ) const
+{
+  if ( isEmpty() || variant.isEmpty() )
+    return isEmpty() && variant.isEmpty();
+  if ( metaData != variant.metaData ) return false;
+  if ( !metaData->canCompareEqual() )
+    throw UnsupportedOperationException{};
+
+  return metaData->equalInstances( payload(), variant.payload() );
+}
+
+bool Variant::operator<( const Variant& variant ) const
+{
+  if ( isEmpty() || variant.isEmpty() )
+    return isEmpty() && !variant.isEmpty();
+  if ( metaData != variant.metaData )
+    return metaData->getTypeIndex() < variant.metaData->getTypeIndex();
+  if ( !metaData->canCompareLess() )
+    throw UnsupportedOperationException{};
+
+  return metaData->lessInstance( payload(), variant.payload() );
+}
+
+void Variant::reset() noexcept
+{
+  if ( pObj != nullptr && metaData != nullptr )
+  {
+    if ( isInArena() )
+      metaData->destroyInstanceAt( payload() );
+    else
+      metaData->destroyInstance( payload() );
+  }
+
+  pObj = nullptr;
+  metaData = nullptr;
+}
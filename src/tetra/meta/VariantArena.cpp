@@ -0,0 +1,88 @@
+#include <tetra/meta/VariantArena.hpp>
+#include <tetra/meta/Memory.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+const size_t blockAlignment = 64;
+
+// payloads are at least 4-aligned, keeping the low two bits of their
+// address free for the Variant's arena and dirty tags
+size_t payloadAlignment( const MetaData& metaData ) noexcept
+{
+  return max<size_t>( metaData.getAlignment(), 4 );
+}
+
+} /* namespace */
+
+VariantArena::~VariantArena()
+{
+  for ( void* block : blocks ) alignedFree( block );
+}
+
+size_t VariantArena::compact( Variant* first, Variant* last )
+{
+  // lay the payloads out back to back, the block is aligned for the
+  // most demanding of them
+  size_t bytes = 0;
+  size_t count = 0;
+  size_t alignment = blockAlignment;
+  for ( Variant* variant = first; variant != last; ++variant )
+  {
+    if ( variant->isEmpty() ) continue;
+
+    const MetaData& metaData = variant->getMetaData();
+    bytes = alignUp( bytes, payloadAlignment( metaData ) ) +
+            metaData.getSize();
+    alignment = max( alignment, metaData.getAlignment() );
+    ++count;
+  }
+
+  if ( count == 0 ) return 0;
+
+  // grow the list first, so the push can not throw and leak the block
+  if ( blocks.size() == blocks.capacity() )
+    blocks.reserve( blocks.size() * 2 + 1 );
+  char* block = reinterpret_cast<char*>(
+    alignedAllocate( max<size_t>( bytes, 1 ), alignment ) );
+  blocks.push_back( block );
+  reservedBytes += bytes;
+
+  size_t offset = 0;
+  for ( Variant* variant = first; variant != last; ++variant )
+  {
+    if ( variant->isEmpty() ) continue;
+
+    const MetaData& metaData = variant->getMetaData();
+    offset = alignUp( offset, payloadAlignment( metaData ) );
+    void* destination = block + offset;
+    offset += metaData.getSize();
+
+    void* source = variant->payload();
+    metaData.relocateInstance( destination, source );
+    if ( !variant->isInArena() ) metaData.deallocateInstance( source );
+
+    bool dirty = variant->isDirty();
+    variant->pObj = destination;
+    variant->setTag( Variant::arenaTag, true );
+    variant->setTag( Variant::dirtyTag, dirty );
+  }
+
+  return count;
+}
+
+size_t VariantArena::getBlockCount() const noexcept
+{
+  return blocks.size();
+}
+
+size_t VariantArena::getReservedBytes() const noexcept
+{
+  return reservedBytes;
+}
@@ -0,0 +1,189 @@
+#include <tetra/meta/VariantPool.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+// grows like MetaArray, so a push_back after this can not throw
+template <typename T>
+void reserveOneMore( vector<T>& values )
+{
+  if ( values.size() == values.capacity() )
+    values.reserve( max<size_t>( 8, values.size() * 2 ) );
+}
+
+} /* namespace */
+
+const size_t VariantHandle::maxTypeIndex;
+const size_t VariantHandle::maxSlot;
+const uint32_t VariantPool::noIndex;
+const uint16_t VariantPool::lastGeneration;
+
+VariantHandle VariantPool::create( const MetaData& metaData )
+{
+  size_t typeIndex = metaData.getTypeIndex();
+  if ( typeIndex > VariantHandle::maxTypeIndex )
+  {
+    throw HandleOverflowException{};
+  }
+
+  if ( typeIndex >= pools.size() ) pools.resize( typeIndex + 1 );
+  if ( !pools[typeIndex] ) pools[typeIndex].reset( new Pool{metaData} );
+
+  Pool& pool = *pools[typeIndex];
+  bool reuse = !pool.freeSlots.empty();
+  size_t slot = reuse ? pool.freeSlots.back() : pool.slots.size();
+
+  // generations start at 1 so that no handle is null
+  uint16_t generation = reuse ? pool.slots[slot].generation : 1;
+  VariantHandle handle =
+    VariantHandle::make( typeIndex, slot, generation );
+
+  // everything which can throw happens before the pool is changed,
+  // so a failed construction neither leaks the slot nor leaves an
+  // owner without a value
+  if ( !reuse ) reserveOneMore( pool.slots );
+  reserveOneMore( pool.owners );
+  pool.values.emplaceBack();
+
+  if ( reuse )
+    pool.freeSlots.pop_back();
+  else
+    pool.slots.push_back( {noIndex, generation} );
+
+  pool.owners.push_back( uint32_t( slot ) );
+  pool.slots[slot].index = static_cast<uint32_t>( pool.owners.size() - 1 );
+
+  return handle;
+}
+
+VariantHandle VariantPool::copy( const Variant& variant )
+{
+  if ( variant.isEmpty() )
+  {
+    throw TypeCastException{};
+  }
+
+  const MetaData& metaData = variant.getMetaData();
+  VariantHandle handle = create( metaData );
+  try
+  {
+    metaData.copyInstance( getPayload( handle ),
+                           variant.getConstPayload() );
+  }
+  catch ( ... )
+  {
+    // the handle never escaped, so nothing refers to the object
+    destroy( handle );
+    throw;
+  }
+
+  return handle;
+}
+
+bool VariantPool::destroy( VariantHandle handle ) noexcept
+{
+  if ( !isValid( handle ) ) return false;
+
+  Pool& pool = *findPool( handle );
+  Slot& slot = pool.slots[handle.getSlot()];
+  uint32_t index = slot.index;
+  uint32_t last = pool.owners.back();
+
+  pool.values.swapRemove( index );
+  pool.owners[index] = last;
+  pool.owners.pop_back();
+  pool.slots[last].index = index;
+
+  slot.index = noIndex;
+
+  // a slot whose generation would wrap is never reused, otherwise
+  // old handles could become valid again
+  if ( slot.generation != lastGeneration )
+  {
+    ++slot.generation;
+    pool.freeSlots.push_back( handle.getSlot() );
+  }
+
+  return true;
+}
+
+bool VariantPool::isValid( VariantHandle handle ) const noexcept
+{
+  return getPayload( handle ) != nullptr;
+}
+
+void* VariantPool::getPayload( VariantHandle handle ) const noexcept
+{
+  Pool* pool = findPool( handle );
+  if ( pool == nullptr || handle.getSlot() >= pool->slots.size() )
+    return nullptr;
+
+  const Slot& slot = pool->slots[handle.getSlot()];
+  if ( slot.generation != handle.getGeneration() ||
+       slot.index == noIndex )
+    return nullptr;
+
+  return pool->values.at( slot.index );
+}
+
+const MetaData*
+VariantPool::getMetaData( VariantHandle handle ) const noexcept
+{
+  Pool* pool = findPool( handle );
+  return pool == nullptr ? nullptr : &pool->values.getMetaData();
+}
+
+size_t VariantPool::size() const noexcept
+{
+  size_t count = 0;
+  for ( const auto& pool : pools )
+  {
+    if ( pool ) count += pool->values.size();
+  }
+
+  return count;
+}
+
+size_t VariantPool::size( const MetaData& metaData ) const noexcept
+{
+  Pool* pool = findPool( metaData );
+  return pool == nullptr ? 0 : pool->values.size();
+}
+
+void VariantPool::shrinkToFit()
+{
+  for ( const auto& pool : pools )
+  {
+    if ( pool ) shrinkToFit( pool->values.getMetaData() );
+  }
+}
+
+void VariantPool::shrinkToFit( const MetaData& metaData )
+{
+  Pool* pool = findPool( metaData );
+  if ( pool == nullptr ) return;
+
+  pool->values.shrinkToFit();
+  pool->owners.shrink_to_fit();
+  pool->freeSlots.shrink_to_fit();
+}
+
+VariantPool::Pool*
+VariantPool::findPool( const MetaData& metaData ) const noexcept
+{
+  size_t index = metaData.getTypeIndex();
+  return index < pools.size() ? pools[index].get() : nullptr;
+}
+
+VariantPool::Pool*
+VariantPool::findPool( VariantHandle handle ) const noexcept
+{
+  size_t index = handle.getTypeIndex();
+  return index < pools.size() ? pools[index].get() : nullptr;
+}
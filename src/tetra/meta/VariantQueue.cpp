@@ -0,0 +1,74 @@
+#include <tetra/meta/VariantQueue.hpp>
+#include <tetra/meta/Memory.hpp>
+
+#include <new>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+constexpr size_t VariantQueue::cacheLineSize;
+
+VariantQueue::VariantQueue( size_t capacity )
+{
+  size_t size = 2;
+  while ( size < capacity ) size *= 2;
+  mask = size - 1;
+
+  cells = reinterpret_cast<Cell*>(
+    alignedAllocate( size * sizeof( Cell ), cacheLineSize ) );
+  for ( size_t i = 0; i < size; ++i )
+  {
+    Cell* cell = new ( cells + i ) Cell{};
+    cell->sequence.store( i, memory_order_relaxed );
+  }
+}
+
+VariantQueue::~VariantQueue()
+{
+  for ( size_t i = 0; i <= mask; ++i ) cells[i].~Cell();
+  alignedFree( cells );
+}
+
+size_t VariantQueue::getCapacity() const noexcept
+{
+  return mask + 1;
+}
+
+bool VariantQueue::tryPush( Variant&& variant ) noexcept
+{
+  size_t position = head.load( memory_order_relaxed );
+  Cell* cell;
+  for ( ;; )
+  {
+    cell = &cells[position & mask];
+    size_t sequence = cell->sequence.load( memory_order_acquire );
+    auto difference = static_cast<ptrdiff_t>( sequence - position );
+
+    if ( difference == 0 )
+    {
+      // the cell is free, claim the position
+      if ( head.compare_exchange_weak( position, position + 1,
+                                       memory_order_relaxed ) )
+        break;
+    }
+    else if ( difference < 0 )
+    {
+      // the consumer has not popped the cell of the previous lap
+      return false;
+    }
+    else
+    {
+      position = head.load( memory_order_relaxed );
+    }
+  }
+
+  cell->variant = move( variant );
+  cell->sequence.store( position + 1, memory_order_release );
+  return true;
+}
+
+bool VariantQueue::tryPop( Variant& out ) noexcept
+{
+  return popBatch( &out, 1 ) == 1;
+}
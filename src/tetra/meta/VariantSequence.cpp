@@ -0,0 +1,139 @@
+#include <tetra/meta/VariantSequence.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+
+namespace
+{
+
+const size_t blockAlignment = 64;
+
+} /* namespace */
+
+VariantSequence::VariantSequence( size_t blockSize ) noexcept
+  : blockSize{blockSize}
+{ }
+
+VariantSequence::~VariantSequence()
+{
+  clear();
+  for ( const Block& block : blocks ) alignedFree( block.memory );
+}
+
+void* VariantSequence::emplace( const MetaData& metaData )
+{
+  Record& record = allocate( metaData );
+  metaData.constructInstanceAt( record.getPayload() );
+  link( record );
+
+  return record.getPayload();
+}
+
+void* VariantSequence::append( const Variant& variant )
+{
+  if ( variant.isEmpty() )
+  {
+    throw TypeCastException{};
+  }
+
+  const MetaData& metaData = variant.getMetaData();
+  void* payload = emplace( metaData );
+  metaData.copyInstance( payload, variant.getConstPayload() );
+
+  return payload;
+}
+
+size_t VariantSequence::size() const noexcept
+{
+  return count;
+}
+
+bool VariantSequence::empty() const noexcept
+{
+  return count == 0;
+}
+
+void VariantSequence::clear() noexcept
+{
+  for ( Record* record = first; record != nullptr; record = record->next )
+  {
+    // trivially copyable types are trivially destructible
+    if ( !record->metaData->isTriviallyCopyable() )
+      record->metaData->destroyInstanceAt( record->getPayload() );
+  }
+
+  first = last = nullptr;
+  count = 0;
+  currentBlock = 0;
+  used = 0;
+}
+
+size_t VariantSequence::getReservedBytes() const noexcept
+{
+  size_t bytes = 0;
+  for ( const Block& block : blocks ) bytes += block.capacity;
+
+  return bytes;
+}
+
+VariantSequence::Record&
+VariantSequence::allocate( const MetaData& metaData )
+{
+  size_t alignment = max( metaData.getAlignment(), alignof( Record ) );
+
+  // places the record at offset in the block if it fits, the payload
+  // is aligned by address so any alignment works
+  auto place = [&]( const Block& block, size_t offset ) -> Record* {
+    uintptr_t base = reinterpret_cast<uintptr_t>( block.memory );
+    size_t header = alignUp( offset, alignof( Record ) );
+    uintptr_t payload =
+      alignUp( base + header + sizeof( Record ), alignment );
+    size_t end = size_t( payload - base ) + metaData.getSize();
+    if ( end > block.capacity ) return nullptr;
+
+    used = end;
+    return reinterpret_cast<Record*>( block.memory + header );
+  };
+
+  Record* record = nullptr;
+  if ( currentBlock < blocks.size() )
+    record = place( blocks[currentBlock], used );
+
+  if ( record == nullptr )
+  {
+    // move on to the next block, inserting a new one if it is
+    // missing or too small for the record
+    if ( !blocks.empty() ) ++currentBlock;
+    if ( currentBlock < blocks.size() )
+      record = place( blocks[currentBlock], 0 );
+
+    if ( record == nullptr )
+    {
+      size_t capacity = max( blockSize, sizeof( Record ) + alignment +
+                                          metaData.getSize() );
+      Block block{reinterpret_cast<char*>(
+                    alignedAllocate( capacity, blockAlignment ) ),
+                  capacity};
+      blocks.insert( blocks.begin() + currentBlock, block );
+      record = place( blocks[currentBlock], 0 );
+    }
+  }
+
+  record->metaData = &metaData;
+  record->next = nullptr;
+  return *record;
+}
+
+void VariantSequence::link( Record& record ) noexcept
+{
+  if ( last == nullptr )
+    first = &record;
+  else
+    last->next = &record;
+
+  last = &record;
+  ++count;
+}
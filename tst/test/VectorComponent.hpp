@@ -2,6 +2,8 @@
 #ifndef TEST_VECTORCOMPONENT_HPP
 #define TEST_VECTORCOMPONENT_HPP
 
+#include <tetra/meta/Fields.hpp>
+
 #include <json/json.h>
 
 namespace test
@@ -23,6 +25,13 @@ public:
   inline void setX(float x) { this->x = x; }
   inline void setY(float y) { this->y = y; }
   inline void setZ(float z) { this->z = z; }
+
+  friend void reflect( tetra::meta::FieldList<VectorComponent>& fields )
+  {
+    fields.add( "x", &VectorComponent::x )
+          .add( "y", &VectorComponent::y )
+          .add( "z", &VectorComponent::z );
+  }
 };
 
 inline 
@@ -10,6 +10,18 @@ Widget::Widget()
   this->myName = "Widget{" + std::to_string( instanceCount ) + "}";
 }
 
+Widget::Widget( const Widget& widget )
+  : myName{widget.myName}
+{
+  ++instanceCount;
+}
+
+Widget::Widget( Widget&& widget )
+  : myName{std::move( widget.myName )}
+{
+  ++instanceCount;
+}
+
 Widget::~Widget()
 {
   --instanceCount;
@@ -21,8 +21,13 @@ public:
 
 public:
   Widget();
+  Widget( const Widget& widget );
+  Widget( Widget&& widget );
   ~Widget();
 
+  Widget& operator=( const Widget& ) = default;
+  Widget& operator=( Widget&& ) = default;
+
   const std::string& getMyName() const noexcept;
 };
 
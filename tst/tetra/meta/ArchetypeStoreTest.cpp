@@ -0,0 +1,137 @@
+#include <tetra/meta/ArchetypeStore.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+#include <test/VectorComponent.hpp>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+using test::VectorComponent;
+
+SCENARIO( "Storing entity components by archetype",
+          "[ArchetypeStore]" )
+{
+  GIVEN( "An ArchetypeStore where some entities have VectorComponents "
+         "and some also have ints" )
+  {
+    ArchetypeStore store{};
+    const Entity entityCount = 3000; // several chunks per archetype
+    for ( Entity entity = 0; entity < entityCount; ++entity )
+    {
+      store.add( entity, VectorComponent{float( entity ), 0, 0} );
+      if ( entity % 2 == 0 ) store.add<int>( entity ) = int( entity );
+    }
+
+    THEN( "Entities with the same components should share an "
+          "archetype" )
+    {
+      REQUIRE( store.getArchetypeCount() == 2 ); // {V} and {V, i}
+      REQUIRE( store.getArchetype( 0 ) == store.getArchetype( 2 ) );
+      REQUIRE( store.getArchetype( 1 ) == store.getArchetype( 3 ) );
+      REQUIRE( store.getArchetype( 0 ) != store.getArchetype( 1 ) );
+      REQUIRE( store.getArchetype( 0 )->getChunkCount() > 1 );
+    }
+
+    THEN( "Components should survive the moves between archetypes" )
+    {
+      bool matching = true;
+      for ( Entity entity = 0; entity < entityCount; ++entity )
+      {
+        matching &= store.get<VectorComponent>( entity )->getX() ==
+                    float( entity );
+        matching &= store.has<int>( entity ) == ( entity % 2 == 0 );
+      }
+      REQUIRE( matching );
+    }
+
+    THEN( "A query should visit exactly the entities with every "
+          "requested component" )
+    {
+      size_t visited = 0;
+      bool matching = true;
+      store.forEach<VectorComponent, int>(
+        [&]( Entity entity, VectorComponent& vec, int& i ) {
+          ++visited;
+          matching &= vec.getX() == float( entity ) &&
+                      i == int( entity );
+        } );
+
+      REQUIRE( visited == entityCount / 2 );
+      REQUIRE( matching );
+    }
+
+    THEN( "Removing components should move entities back and keep "
+          "the other entities intact" )
+    {
+      for ( Entity entity = 0; entity < entityCount; entity += 4 )
+        REQUIRE( store.remove<int>( entity ) );
+      REQUIRE( !store.remove<int>( 0 ) );
+
+      size_t withInt = 0;
+      store.forEach<int>( [&]( Entity entity, int& i ) {
+        ++withInt;
+        REQUIRE( i == int( entity ) );
+      } );
+      REQUIRE( withInt == entityCount / 4 );
+
+      size_t withVector = 0;
+      bool matching = true;
+      store.forEach<VectorComponent>(
+        [&]( Entity entity, VectorComponent& vec ) {
+          ++withVector;
+          matching &= vec.getX() == float( entity );
+        } );
+      REQUIRE( withVector == entityCount );
+      REQUIRE( matching );
+    }
+
+    THEN( "removeAll should detach the entity from every archetype" )
+    {
+      store.removeAll( 10 );
+
+      REQUIRE( store.getArchetype( 10 ) == nullptr );
+      REQUIRE( store.get<VectorComponent>( 10 ) == nullptr );
+      REQUIRE( store.get<VectorComponent>( 12 )->getX() == 12.0f );
+    }
+  }
+
+  GIVEN( "An ArchetypeStore holding Widgets" )
+  {
+    {
+      ArchetypeStore store{};
+      for ( Entity entity = 0; entity < 100; ++entity )
+      {
+        store.add<Widget>( entity );
+        store.add<int>( entity );
+      }
+      store.remove<Widget>( 5 );
+
+      THEN( "Moving entities should neither leak nor double destroy "
+            "Widgets" )
+      {
+        REQUIRE( Widget::getInstanceCount() == 99 );
+      }
+    }
+
+    THEN( "Destroying the store should destroy the Widgets" )
+    {
+      REQUIRE( Widget::getInstanceCount() == 0 );
+    }
+  }
+
+  GIVEN( "An entity above maxEntity" )
+  {
+    ArchetypeStore store{};
+    const Entity invalid = maxEntity + 1;
+
+    THEN( "Adding a component to it should throw" )
+    {
+      REQUIRE_THROWS_AS( store.add<int>( invalid ),
+                         InvalidEntityException );
+      REQUIRE( store.get<int>( invalid ) == nullptr );
+      REQUIRE( store.getArchetype( invalid ) == nullptr );
+    }
+  }
+}
@@ -0,0 +1,183 @@
+#include <tetra/meta/AtomicVariantSlot.hpp>
+
+#include <catch.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+/**
+ * Throws from its copy assignment while failCopies is set.
+ **/
+struct FragileCopy
+{
+  static bool failCopies;
+  int value{0};
+
+  FragileCopy() = default;
+  FragileCopy( const FragileCopy& ) = default;
+
+  FragileCopy& operator=( const FragileCopy& other )
+  {
+    if ( failCopies ) throw runtime_error{"copy failed"};
+    value = other.value;
+    return *this;
+  }
+};
+
+bool FragileCopy::failCopies = false;
+
+} /* namespace */
+
+SCENARIO( "Publishing the latest value through an AtomicVariantSlot",
+          "[AtomicVariantSlot]" )
+{
+  GIVEN( "A slot for a trivially copyable type" )
+  {
+    AtomicVariantSlot slot{MetaData::get<VectorComponent>()};
+
+    THEN( "It should use the seqlock" )
+    {
+      REQUIRE( slot.isSeqLocked() );
+    }
+
+    THEN( "Loads should return the latest store" )
+    {
+      REQUIRE( slot.load<VectorComponent>().getX() == 0.0f );
+
+      slot.store( VectorComponent{1, 2, 3} );
+      slot.store( Variant::create( VectorComponent{4, 5, 6} ) );
+
+      Variant out{};
+      slot.load( out );
+      REQUIRE( out.getObject<VectorComponent>().getY() == 5.0f );
+    }
+
+    THEN( "Storing another type should throw" )
+    {
+      REQUIRE_THROWS_AS( slot.store( 5 ), TypeCastException );
+      REQUIRE_THROWS_AS( slot.store( Variant::create( 5 ) ),
+                         TypeCastException );
+    }
+
+    THEN( "Concurrent loads should never see a torn value" )
+    {
+      atomic<bool> done{false};
+      thread writer{[&]() {
+        for ( int i = 1; i <= 20000; ++i )
+        {
+          float value = float( i );
+          slot.store( VectorComponent{value, value, value} );
+        }
+        done = true;
+      }};
+
+      bool torn = false;
+      while ( !done )
+      {
+        VectorComponent value = slot.load<VectorComponent>();
+        torn = torn || value.getX() != value.getY() ||
+               value.getY() != value.getZ();
+      }
+      writer.join();
+
+      REQUIRE( !torn );
+      REQUIRE( slot.load<VectorComponent>().getX() == 20000.0f );
+    }
+  }
+
+  GIVEN( "A slot for a type which is not trivially copyable" )
+  {
+    AtomicVariantSlot slot{MetaData::get<string>()};
+
+    THEN( "It should use the triple buffer" )
+    {
+      REQUIRE( !slot.isSeqLocked() );
+    }
+
+    THEN( "Loads should return the latest store" )
+    {
+      REQUIRE( slot.load<string>().empty() );
+
+      slot.store( string{"first"} );
+      REQUIRE( slot.load<string>() == "first" );
+
+      slot.store( string{"second"} );
+      slot.store( string{"third"} );
+      REQUIRE( slot.load<string>() == "third" );
+      REQUIRE( slot.load<string>() == "third" );
+    }
+
+    THEN( "A concurrent reader should see whole, increasing values" )
+    {
+      atomic<bool> done{false};
+      thread writer{[&]() {
+        for ( int i = 1; i <= 20000; ++i )
+          slot.store( string( 40, 'a' ) + to_string( i ) );
+        done = true;
+      }};
+
+      bool valid = true;
+      int last = 0;
+      while ( !done )
+      {
+        string value = slot.load<string>();
+        if ( value.empty() ) continue;
+
+        int number = stoi( value.substr( 40 ) );
+        valid = valid && value.compare( 0, 40, string( 40, 'a' ) ) == 0 &&
+                number >= last;
+        last = number;
+      }
+      writer.join();
+
+      REQUIRE( valid );
+      REQUIRE( slot.load<string>() == string( 40, 'a' ) + "20000" );
+    }
+  }
+
+  GIVEN( "A triple buffered slot for a type whose copy can throw" )
+  {
+    AtomicVariantSlot slot{MetaData::get<FragileCopy>()};
+    FragileCopy first{};
+    first.value = 1;
+    slot.store( first );
+
+    WHEN( "A store throws" )
+    {
+      FragileCopy second{};
+      second.value = 2;
+      FragileCopy::failCopies = true;
+      REQUIRE_THROWS_AS( slot.store( second ), runtime_error );
+      FragileCopy::failCopies = false;
+
+      THEN( "The last published value should still be loaded" )
+      {
+        REQUIRE( !slot.isSeqLocked() );
+        REQUIRE( slot.load<FragileCopy>().value == 1 );
+      }
+    }
+
+    WHEN( "A load throws" )
+    {
+      FragileCopy::failCopies = true;
+      REQUIRE_THROWS_AS( slot.load<FragileCopy>(), runtime_error );
+      FragileCopy::failCopies = false;
+
+      THEN( "The value should be loaded by the next load" )
+      {
+        REQUIRE( slot.load<FragileCopy>().value == 1 );
+      }
+    }
+  }
+}
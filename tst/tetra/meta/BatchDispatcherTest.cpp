@@ -0,0 +1,122 @@
+#include <tetra/meta/BatchDispatcher.hpp>
+
+#include <catch.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+SCENARIO( "Dispatching Variants in batches by type",
+          "[BatchDispatcher]" )
+{
+  GIVEN( "A BatchDispatcher with handlers for ints and strings" )
+  {
+    BatchDispatcher dispatcher{};
+
+    vector<int> ints;
+    vector<string> strings;
+    int intBatches = 0;
+    vector<float> unhandled;
+
+    dispatcher.addHandler<int>( [&]( PayloadSpan<int> span ) {
+      ++intBatches;
+      for ( int& value : span ) ints.push_back( value );
+    } );
+    dispatcher.addHandler<string>( [&]( PayloadSpan<string> span ) {
+      for ( size_t i = 0; i < span.size(); ++i )
+        strings.push_back( span[i] );
+    } );
+    dispatcher.setFallback( [&]( Variant& message ) {
+      unhandled.push_back(
+        message.isEmpty() ? -1.0f
+                          : message.getObject<VectorComponent>().getX() );
+    } );
+
+    vector<Variant> messages;
+    messages.push_back( Variant::create( 1 ) );
+    messages.push_back( Variant::create( string{"a"} ) );
+    messages.push_back( Variant::create( VectorComponent{7, 0, 0} ) );
+    messages.push_back( Variant::create( 2 ) );
+    messages.push_back( Variant{} );
+    messages.push_back( Variant::create( string{"b"} ) );
+    messages.push_back( Variant::create( 3 ) );
+    messages.push_back( Variant::create( VectorComponent{8, 0, 0} ) );
+
+    WHEN( "The messages are dispatched" )
+    {
+      size_t handled = dispatcher.dispatch( messages );
+
+      THEN( "Each handler should get its payloads in one stable batch" )
+      {
+        REQUIRE( handled == 5 );
+        REQUIRE( intBatches == 1 );
+        REQUIRE( ( ints == vector<int>{1, 2, 3} ) );
+        REQUIRE( ( strings == vector<string>{"a", "b"} ) );
+      }
+
+      THEN( "Unhandled messages should reach the fallback in order" )
+      {
+        REQUIRE( ( unhandled == vector<float>{7.0f, -1.0f, 8.0f} ) );
+      }
+
+      THEN( "Dispatching again should reuse the handlers" )
+      {
+        dispatcher.dispatch( messages.data(), messages.data() + 1 );
+        REQUIRE( intBatches == 2 );
+        REQUIRE( ints.back() == 1 );
+      }
+    }
+
+    THEN( "Handled types should be reported" )
+    {
+      REQUIRE( dispatcher.handles( MetaData::get<int>() ) );
+      REQUIRE( !dispatcher.handles( MetaData::get<VectorComponent>() ) );
+    }
+
+    THEN( "Dispatching nothing should call nothing" )
+    {
+      vector<Variant> none;
+      REQUIRE( dispatcher.dispatch( none ) == 0 );
+      REQUIRE( intBatches == 0 );
+    }
+  }
+
+  GIVEN( "A handler which runs standard algorithms over its span" )
+  {
+    BatchDispatcher dispatcher{};
+    ptrdiff_t distance = 0;
+    dispatcher.addHandler<int>( [&]( PayloadSpan<int> span ) {
+      distance = std::distance( span.begin(), span.end() );
+      std::sort( span.begin(), span.end() );
+    } );
+
+    vector<Variant> messages;
+    for ( int value : {5, 3, 9, 1} )
+      messages.push_back( Variant::create( value ) );
+
+    THEN( "The span's iterators should be random access" )
+    {
+      REQUIRE( dispatcher.dispatch( messages ) == 4 );
+      REQUIRE( distance == 4 );
+      REQUIRE( messages[0].getConstObject<int>() == 1 );
+      REQUIRE( messages[1].getConstObject<int>() == 3 );
+      REQUIRE( messages[3].getConstObject<int>() == 9 );
+
+      int values[3] = {7, 8, 9};
+      void* payloads[3] = {&values[0], &values[1], &values[2]};
+      PayloadSpan<int> span{payloads, 3};
+      PayloadSpan<int>::Iterator iter = span.begin();
+      REQUIRE( ( ( iter + 2 ) - iter == 2 ) );
+      REQUIRE( ( 2 + iter ) > iter );
+      REQUIRE( iter[1] == 8 );
+      REQUIRE( *( span.end() - 1 ) == 9 );
+    }
+  }
+}
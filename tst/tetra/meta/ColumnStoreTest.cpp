@@ -0,0 +1,163 @@
+#include <tetra/meta/ColumnStore.hpp>
+
+#include <catch.hpp>
+#include <test/VectorComponent.hpp>
+#include <test/Widget.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+using test::Widget;
+
+namespace columns
+{
+
+struct Particle
+{
+  float x, y;
+  int life;
+};
+
+void reflect( FieldList<Particle>& fields )
+{
+  fields.add( "x", &Particle::x )
+        .add( "y", &Particle::y )
+        .add( "life", &Particle::life );
+}
+
+struct Named
+{
+  string name;
+};
+
+void reflect( FieldList<Named>& fields )
+{
+  fields.add( "name", &Named::name );
+}
+
+} /* namespace columns */
+
+using columns::Particle;
+using columns::Named;
+
+SCENARIO( "Storing reflected components in columns", "[ColumnStore]" )
+{
+  GIVEN( "A ColumnStore for a reflected trivially copyable type" )
+  {
+    ColumnStore store{MetaData::get<Particle>()};
+
+    for ( Entity entity = 0; entity < 100; ++entity )
+      store.add( entity, Particle{float( entity ), 1.0f,
+                                  int( entity ) * 2} );
+
+    THEN( "Every field should get its own aligned column" )
+    {
+      REQUIRE( store.size() == 100 );
+      REQUIRE( store.getColumnCount() == 3 );
+      REQUIRE( store.getField( 2 ).name == "life" );
+
+      for ( size_t i = 0; i < store.getColumnCount(); ++i )
+      {
+        auto address = reinterpret_cast<uintptr_t>( store.getColumn( i ) );
+        REQUIRE( ( address % 64 == 0 ) );
+      }
+
+      float* x = store.column( &Particle::x );
+      int* life = store.column( &Particle::life );
+      REQUIRE( x == store.getColumn( 0 ) );
+      REQUIRE( x[42] == 42.0f );
+      REQUIRE( life[42] == 84 );
+      REQUIRE( store.column<int>( "life" ) == life );
+    }
+
+    THEN( "Proxy references should read and write single fields" )
+    {
+      ColumnRef<Particle> ref = store.at<Particle>( store.find( 7 ) );
+      REQUIRE( ref.field( &Particle::x ) == 7.0f );
+
+      ref.field( &Particle::y ) = 5.0f;
+      Particle gathered = ref;
+      REQUIRE( gathered.x == 7.0f );
+      REQUIRE( gathered.y == 5.0f );
+      REQUIRE( gathered.life == 14 );
+
+      ref = Particle{-1.0f, -2.0f, -3};
+      REQUIRE( store.column( &Particle::y )[7] == -2.0f );
+    }
+
+    THEN( "Adding an existing entity should replace its component" )
+    {
+      size_t slot = store.add( 3, Particle{9.0f, 9.0f, 9} );
+      REQUIRE( slot == store.find( 3 ) );
+      REQUIRE( store.size() == 100 );
+      REQUIRE( store.column( &Particle::life )[slot] == 9 );
+    }
+
+    WHEN( "A component is removed" )
+    {
+      REQUIRE( store.remove( 10 ) );
+
+      THEN( "The last component should move into its slot" )
+      {
+        REQUIRE( !store.has( 10 ) );
+        REQUIRE( !store.remove( 10 ) );
+        REQUIRE( store.size() == 99 );
+        REQUIRE( store.find( 99 ) == 10 );
+        REQUIRE( store.getOwners()[10] == 99 );
+        REQUIRE( store.column( &Particle::x )[10] == 99.0f );
+        REQUIRE( store.column( &Particle::life )[10] == 198 );
+      }
+    }
+
+    THEN( "Mismatched types and fields should throw" )
+    {
+      REQUIRE_THROWS_AS( store.at<VectorComponent>( 0 ),
+                         TypeCastException );
+      REQUIRE_THROWS_AS( store.column<float>( "life" ),
+                         TypeCastException );
+      REQUIRE_THROWS_AS( store.column<float>( "missing" ),
+                         TypeCastException );
+      REQUIRE_THROWS_AS( store.add( 0, VectorComponent{} ),
+                         TypeCastException );
+      REQUIRE( store.find( 1000 ) == ColumnStore::npos );
+    }
+
+    THEN( "Adding an entity above maxEntity should throw" )
+    {
+      REQUIRE_THROWS_AS( store.add( maxEntity + 1, Particle{} ),
+                         InvalidEntityException );
+      REQUIRE( !store.has( maxEntity + 1 ) );
+      REQUIRE( store.size() == 100 );
+    }
+  }
+
+  GIVEN( "A ColumnStore for a type with inaccessible members" )
+  {
+    ColumnStore store{MetaData::get<VectorComponent>()};
+    store.add( 4, VectorComponent{1.0f, 2.0f, 3.0f} );
+
+    THEN( "Its columns should be accessible by name" )
+    {
+      store.column<float>( "z" )[0] += 1.0f;
+
+      VectorComponent vector = store.at<VectorComponent>( 0 );
+      REQUIRE( vector.getY() == 2.0f );
+      REQUIRE( vector.getZ() == 4.0f );
+    }
+  }
+
+  GIVEN( "Types without trivially copyable reflected fields" )
+  {
+    THEN( "Creating a ColumnStore should throw" )
+    {
+      REQUIRE_THROWS_AS( ColumnStore{MetaData::get<Widget>()},
+                         ColumnLayoutException );
+      REQUIRE_THROWS_AS( ColumnStore{MetaData::get<Named>()},
+                         ColumnLayoutException );
+    }
+  }
+}
@@ -0,0 +1,115 @@
+#include <tetra/meta/CompactVariant.hpp>
+
+#include <catch.hpp>
+#include <json/json.h>
+#include <test/Widget.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+using test::VectorComponent;
+
+namespace
+{
+
+struct alignas( 64 ) CacheLine
+{
+  int value{0};
+};
+
+} /* namespace */
+
+SCENARIO( "Holding payloads in a single pointer CompactVariant",
+          "[CompactVariant]" )
+{
+  GIVEN( "A CompactVariant holding a VectorComponent" )
+  {
+    CompactVariant variant =
+      CompactVariant::create( VectorComponent{1, 2, 3} );
+
+    THEN( "It should be one pointer wide and hold the payload" )
+    {
+      REQUIRE( sizeof( CompactVariant ) == sizeof( void* ) );
+      REQUIRE( !variant.isEmpty() );
+      REQUIRE( variant.holds( MetaData::get<VectorComponent>() ) );
+      REQUIRE( variant.getObject<VectorComponent>().getZ() == 3.0f );
+      REQUIRE( variant.tryGetObject<int>() == nullptr );
+      REQUIRE_THROWS_AS( variant.getObject<int>(), TypeCastException );
+    }
+
+    THEN( "Moving should leave the source empty" )
+    {
+      CompactVariant moved{move( variant )};
+
+      REQUIRE( variant.isEmpty() );
+      REQUIRE( variant.getMetaData() == nullptr );
+      REQUIRE( moved.getObject<VectorComponent>().getX() == 1.0f );
+    }
+
+    THEN( "It should serialize like a Variant" )
+    {
+      Json::Value root{};
+      REQUIRE( variant.serialize( root ) );
+
+      CompactVariant loaded{MetaData::get<VectorComponent>()};
+      REQUIRE( loaded.deserialize( root ) );
+      REQUIRE( loaded.getObject<VectorComponent>().getY() == 2.0f );
+      REQUIRE( !CompactVariant{}.serialize( root ) );
+    }
+  }
+
+  GIVEN( "Variants and CompactVariants to copy from" )
+  {
+    Variant source = Variant::create( string{"copied"} );
+    CompactVariant variant = CompactVariant::create( 5 );
+
+    THEN( "Copying should take the payload and the type" )
+    {
+      variant.copy( source );
+      REQUIRE( variant.getObject<string>() == "copied" );
+
+      CompactVariant other{};
+      other.copy( variant );
+      REQUIRE( other.getObject<string>() == "copied" );
+      REQUIRE( other.getPayload() != variant.getPayload() );
+
+      other.copy( CompactVariant{} );
+      REQUIRE( other.isEmpty() );
+    }
+  }
+
+  GIVEN( "An over-aligned type" )
+  {
+    CompactVariant variant{MetaData::get<CacheLine>()};
+
+    THEN( "The payload should keep its alignment" )
+    {
+      uintptr_t address =
+        reinterpret_cast<uintptr_t>( variant.getPayload() );
+      REQUIRE( ( address % 64 == 0 ) );
+      REQUIRE( variant.getObject<CacheLine>().value == 0 );
+    }
+  }
+
+  GIVEN( "CompactVariants holding Widgets" )
+  {
+    int widgets = Widget::getInstanceCount();
+    {
+      CompactVariant first{MetaData::get<Widget>()};
+      CompactVariant second{MetaData::get<Widget>()};
+      second = move( first );
+      REQUIRE( Widget::getInstanceCount() == widgets + 1 );
+    }
+
+    THEN( "Every Widget should be destroyed" )
+    {
+      REQUIRE( Widget::getInstanceCount() == widgets );
+    }
+  }
+}
@@ -0,0 +1,112 @@
+#include <tetra/meta/ComponentStore.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+#include <test/VectorComponent.hpp>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+using test::VectorComponent;
+
+SCENARIO( "Storing entity components by type in a ComponentStore",
+          "[ComponentStore]" )
+{
+  GIVEN( "A ComponentStore with VectorComponents on a few entities" )
+  {
+    ComponentStore store{};
+    for ( Entity entity = 0; entity < 10; ++entity )
+      store.add( entity, VectorComponent{float( entity ), 0, 0} );
+
+    store.add<int>( 3 ) = 33;
+
+    THEN( "Components should be found by entity and type" )
+    {
+      REQUIRE( store.get<VectorComponent>( 4 )->getX() == 4.0f );
+      REQUIRE( *store.get<int>( 3 ) == 33 );
+      REQUIRE( store.get<int>( 4 ) == nullptr );
+      REQUIRE( store.get<Widget>( 4 ) == nullptr );
+      REQUIRE( store.has<int>( 3 ) );
+    }
+
+    THEN( "Components of one type should be contiguous" )
+    {
+      ComponentView<VectorComponent> view =
+        store.components<VectorComponent>();
+
+      REQUIRE( view.size() == 10 );
+      REQUIRE( ( view.end() - view.begin() == 10 ) );
+
+      bool matching = true;
+      for ( size_t i = 0; i < view.size(); ++i )
+        matching &= view[i].getX() == float( view.entity( i ) );
+      REQUIRE( matching );
+    }
+
+    THEN( "Adding an existing component should return the existing "
+          "component" )
+    {
+      REQUIRE( &store.add<VectorComponent>( 2 ) ==
+               store.get<VectorComponent>( 2 ) );
+      REQUIRE( store.size( MetaData::get<VectorComponent>() ) == 10 );
+    }
+
+    THEN( "Removing a component should keep the others reachable" )
+    {
+      REQUIRE( store.remove<VectorComponent>( 0 ) );
+      REQUIRE( !store.remove<VectorComponent>( 0 ) );
+
+      REQUIRE( store.get<VectorComponent>( 0 ) == nullptr );
+      REQUIRE( store.get<VectorComponent>( 9 )->getX() == 9.0f );
+
+      float sum = 0;
+      store.forEach<VectorComponent>(
+        [&]( Entity, VectorComponent& vec ) { sum += vec.getX(); } );
+      REQUIRE( sum == 45.0f );
+    }
+
+    THEN( "removeAll should remove every component of an entity" )
+    {
+      store.removeAll( 3 );
+
+      REQUIRE( !store.has<int>( 3 ) );
+      REQUIRE( !store.has<VectorComponent>( 3 ) );
+      REQUIRE( store.components<VectorComponent>().size() == 9 );
+    }
+  }
+
+  GIVEN( "A ComponentStore holding Widgets" )
+  {
+    {
+      ComponentStore store{};
+      store.add<Widget>( 1 );
+      store.add<Widget>( 2 );
+      store.remove<Widget>( 1 );
+
+      THEN( "Removed Widgets should be destroyed" )
+      {
+        REQUIRE( Widget::getInstanceCount() == 1 );
+      }
+    }
+
+    THEN( "Destroying the store should destroy the Widgets" )
+    {
+      REQUIRE( Widget::getInstanceCount() == 0 );
+    }
+  }
+
+  GIVEN( "An entity above maxEntity" )
+  {
+    ComponentStore store{};
+    const Entity invalid = maxEntity + 1;
+
+    THEN( "Adding a component to it should throw" )
+    {
+      REQUIRE_THROWS_AS( store.add<VectorComponent>( invalid ),
+                         InvalidEntityException );
+      REQUIRE( !store.has<VectorComponent>( invalid ) );
+      REQUIRE( store.components<VectorComponent>().size() == 0 );
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#include <tetra/meta/Dispatcher.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+using test::VectorComponent;
+
+SCENARIO( "Dispatching Variants to typed handlers", "[Dispatcher]" )
+{
+  GIVEN( "A Dispatcher with handlers for VectorComponents and ints" )
+  {
+    Dispatcher dispatcher{};
+
+    float xSum = 0.0f;
+    int intSum = 0;
+    int fallbackCount = 0;
+
+    dispatcher.addHandler<VectorComponent>(
+      [&]( VectorComponent& vec ) { xSum += vec.getX(); } );
+    dispatcher.addHandler<int>( [&]( int& i ) { intSum += i; } );
+
+    THEN( "Variants should be routed by their payload type" )
+    {
+      Variant vec = Variant::create( VectorComponent{2.0f, 0, 0} );
+      Variant number = Variant::create( 5 );
+
+      REQUIRE( dispatcher.dispatch( vec ) );
+      REQUIRE( dispatcher.dispatch( number ) );
+      REQUIRE( dispatcher.dispatch( number ) );
+
+      REQUIRE( xSum == 2.0f );
+      REQUIRE( intSum == 10 );
+    }
+
+    THEN( "Handlers should be able to modify the payload" )
+    {
+      dispatcher.addHandler<int>( []( int& i ) { i = 7; } );
+
+      Variant number = Variant::create( 5 );
+      dispatcher.dispatch( number );
+
+      REQUIRE( number.getObject<int>() == 7 );
+    }
+
+    THEN( "handles should report which types have handlers" )
+    {
+      REQUIRE( dispatcher.handles( MetaData::get<int>() ) );
+      REQUIRE( !dispatcher.handles( MetaData::get<Widget>() ) );
+    }
+
+    THEN( "Unhandled types should go to the fallback" )
+    {
+      string fallbackType{};
+      dispatcher.setFallback( [&]( Variant& message ) {
+        ++fallbackCount;
+        if ( message.holds( MetaData::get<Widget>() ) )
+          fallbackType = "Widget";
+      } );
+
+      Variant widget{MetaData::get<Widget>()};
+      Variant empty{};
+
+      REQUIRE( !dispatcher.dispatch( widget ) );
+      REQUIRE( !dispatcher.dispatch( empty ) );
+      REQUIRE( fallbackCount == 2 );
+      REQUIRE( fallbackType == "Widget" );
+    }
+
+    THEN( "Unhandled types without a fallback should be ignored" )
+    {
+      Variant widget{MetaData::get<Widget>()};
+      REQUIRE( !dispatcher.dispatch( widget ) );
+    }
+  }
+}
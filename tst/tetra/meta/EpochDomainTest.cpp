@@ -0,0 +1,147 @@
+#include <tetra/meta/EpochDomain.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+
+SCENARIO( "Deferring Variant destruction with an EpochDomain",
+          "[EpochDomain]" )
+{
+  GIVEN( "A domain with a writer and a reader participant" )
+  {
+    int widgets = Widget::getInstanceCount();
+
+    EpochDomain domain{};
+    EpochDomain::Participant writer{domain};
+    EpochDomain::Participant reader{domain};
+
+    WHEN( "A Widget is retired while the reader is pinned" )
+    {
+      auto guard = reader.pin();
+      REQUIRE( reader.isPinned() );
+
+      writer.retire( Variant::create( Widget{} ) );
+      REQUIRE( writer.getRetiredCount() == 1 );
+
+      THEN( "It should not be destroyed until the reader unpins" )
+      {
+        for ( int i = 0; i < 4; ++i ) writer.collect();
+        REQUIRE( writer.getRetiredCount() == 1 );
+        REQUIRE( Widget::getInstanceCount() == widgets + 1 );
+
+        {
+          EpochDomain::Guard moved{move( guard )};
+        }
+        REQUIRE( !reader.isPinned() );
+
+        size_t destroyed = 0;
+        for ( int i = 0; i < 4; ++i ) destroyed += writer.collect();
+        REQUIRE( destroyed == 1 );
+        REQUIRE( Widget::getInstanceCount() == widgets );
+      }
+    }
+
+    THEN( "Nested pins should keep the participant pinned" )
+    {
+      {
+        auto outer = reader.pin();
+        {
+          auto inner = reader.pin();
+        }
+        REQUIRE( reader.isPinned() );
+      }
+      REQUIRE( !reader.isPinned() );
+    }
+
+    THEN( "The epoch should only advance past pinned participants once" )
+    {
+      auto guard = reader.pin();
+      size_t epoch = domain.getEpoch();
+
+      REQUIRE( domain.tryAdvance() );
+      REQUIRE( !domain.tryAdvance() );
+      REQUIRE( domain.getEpoch() == epoch + 1 );
+    }
+  }
+
+  GIVEN( "A Variant retired by a participant which is destroyed" )
+  {
+    int widgets = Widget::getInstanceCount();
+
+    EpochDomain domain{};
+    EpochDomain::Participant reader{domain};
+    {
+      auto guard = reader.pin();
+      {
+        EpochDomain::Participant writer{domain};
+        writer.retire( Variant::create( Widget{} ) );
+      }
+      domain.tryAdvance();
+      domain.tryAdvance();
+      REQUIRE( Widget::getInstanceCount() == widgets + 1 );
+    }
+
+    THEN( "The domain should destroy it once it is unreadable" )
+    {
+      domain.tryAdvance();
+      domain.tryAdvance();
+      REQUIRE( Widget::getInstanceCount() == widgets );
+    }
+  }
+
+  GIVEN( "Readers of a string which a writer keeps replacing" )
+  {
+    EpochDomain domain{};
+    Variant initial = Variant::create( string( 32, 'a' ) );
+    atomic<const string*> current{&initial.getObject<string>()};
+    atomic<bool> done{false};
+    atomic<bool> valid{true};
+
+    vector<thread> readers;
+    for ( int i = 0; i < 3; ++i )
+    {
+      readers.emplace_back( [&]() {
+        EpochDomain::Participant participant{domain};
+        while ( !done )
+        {
+          auto guard = participant.pin();
+          const string* value = current.load( memory_order_acquire );
+          if ( value->size() != 32 ) valid = false;
+        }
+      } );
+    }
+
+    {
+      EpochDomain::Participant writer{domain};
+      Variant published = move( initial );
+      for ( int i = 0; i < 5000; ++i )
+      {
+        Variant next =
+          Variant::create( string( 32, char( 'a' + i % 26 ) ) );
+        current.store( &next.getObject<string>(), memory_order_release );
+        writer.retire( move( published ) );
+        published = move( next );
+      }
+
+      done = true;
+      for ( auto& reader : readers ) reader.join();
+
+      THEN( "Readers should only ever see live strings" )
+      {
+        REQUIRE( valid );
+        writer.collect();
+        writer.collect();
+        REQUIRE( writer.getRetiredCount() == 0 );
+      }
+    }
+  }
+}
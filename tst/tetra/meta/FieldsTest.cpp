@@ -0,0 +1,205 @@
+#include <tetra/meta/Fields.hpp>
+#include <tetra/meta/Variant.hpp>
+
+#include <catch.hpp>
+#include <json/json.h>
+#include <test/VectorComponent.hpp>
+#include <test/Widget.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+using test::Widget;
+
+namespace reflected
+{
+
+struct Player
+{
+  string name;
+  int score;
+  double speed;
+  bool active;
+  uint16_t level;
+};
+
+void reflect( FieldList<Player>& fields )
+{
+  fields.add( "name", &Player::name )
+        .add( "score", &Player::score )
+        .add( "speed", &Player::speed )
+        .add( "active", &Player::active )
+        .add( "level", &Player::level );
+}
+
+} /* namespace reflected */
+
+using reflected::Player;
+
+SCENARIO( "Generating serializers from reflected fields", "[Fields]" )
+{
+  GIVEN( "MetaData for a type with only reflected fields" )
+  {
+    const MetaData& metaData = MetaData::get<Player>();
+    const TypeFields* fields = metaData.getFields();
+
+    THEN( "The fields should be registered in declaration order" )
+    {
+      REQUIRE( HasReflection<Player>::value );
+      REQUIRE( !HasReflection<Widget>::value );
+      REQUIRE( MetaData::get<Widget>().getFields() == nullptr );
+
+      REQUIRE( fields != nullptr );
+      REQUIRE( fields->getFields().size() == 5 );
+      REQUIRE( fields->getFields()[1].name == "score" );
+      REQUIRE( fields->getFields()[1].metaData == &MetaData::get<int>() );
+      REQUIRE( fields->find( "speed" )->offset ==
+               offsetof( Player, speed ) );
+      REQUIRE( fields->find( "missing" ) == nullptr );
+    }
+
+    THEN( "It should be serializable through generated functions" )
+    {
+      REQUIRE( metaData.canSerialize() );
+
+      Variant player = Variant::create(
+        Player{"tetra", 42, 1.5, true, uint16_t( 7 )} );
+      Json::Value root{};
+      REQUIRE( player.serialize( root ) );
+      REQUIRE( root["name"].asString() == "tetra" );
+      REQUIRE( root["score"].asInt() == 42 );
+      REQUIRE( root["active"].asBool() );
+
+      Variant loaded{metaData};
+      REQUIRE( loaded.deserialize( root ) );
+      const Player& copy = loaded.getObject<Player>();
+      REQUIRE( copy.name == "tetra" );
+      REQUIRE( copy.score == 42 );
+      REQUIRE( copy.speed == 1.5 );
+      REQUIRE( copy.active );
+      REQUIRE( copy.level == 7 );
+    }
+
+    THEN( "Deserializing should skip unknown members and keep missing "
+          "fields" )
+    {
+      Json::Value root{};
+      root["aaa"] = 1;
+      root["level"] = 3;
+      root["other"] = "ignored";
+      root["zzz"] = true;
+
+      Player player{};
+      player.score = 9;
+      REQUIRE( fields->deserialize( &player, root ) );
+      REQUIRE( player.level == 3 );
+      REQUIRE( player.score == 9 );
+    }
+
+    THEN( "Deserializing mismatched values should fail" )
+    {
+      Json::Value root{};
+      root["score"] = "not a number";
+
+      Player player{};
+      REQUIRE( !fields->deserialize( &player, root ) );
+      REQUIRE( !fields->deserialize( &player, Json::Value{5} ) );
+    }
+
+    THEN( "Deserializing values which do not fit their field should fail" )
+    {
+      Json::Value tooBig{};
+      tooBig["score"] = Json::Int64( 4000000000 );
+      Json::Value tooSmall{};
+      tooSmall["score"] = Json::Int64( -4000000000 );
+      Json::Value huge{};
+      huge["score"] = 1e30;
+      Json::Value fraction{};
+      fraction["score"] = 1.5;
+      Json::Value negative{};
+      negative["level"] = -1;
+      Json::Value wide{};
+      wide["level"] = 70000;
+
+      Player player{};
+      player.score = 3;
+      player.level = 4;
+      REQUIRE( !fields->deserialize( &player, tooBig ) );
+      REQUIRE( !fields->deserialize( &player, tooSmall ) );
+      REQUIRE( !fields->deserialize( &player, huge ) );
+      REQUIRE( !fields->deserialize( &player, fraction ) );
+      REQUIRE( !fields->deserialize( &player, negative ) );
+      REQUIRE( !fields->deserialize( &player, wide ) );
+      REQUIRE( player.score == 3 );
+      REQUIRE( player.level == 4 );
+
+      Json::Value limits{};
+      limits["score"] = -2147483647 - 1;
+      limits["level"] = 65535;
+      limits["speed"] = 1e300;
+      REQUIRE( fields->deserialize( &player, limits ) );
+      REQUIRE( player.score == -2147483647 - 1 );
+      REQUIRE( player.level == 65535 );
+      REQUIRE( player.speed == 1e300 );
+    }
+
+    THEN( "The binary format should round trip" )
+    {
+      Variant player =
+        Variant::create( Player{"binary", -3, 2.25, true, 9} );
+      string buffer;
+      REQUIRE( player.writeBinary( buffer ) );
+      REQUIRE( buffer.size() == 4 + 6 + sizeof( int ) +
+                                  sizeof( double ) + sizeof( bool ) +
+                                  sizeof( uint16_t ) );
+
+      Variant loaded{metaData};
+      const char* begin = buffer.data();
+      REQUIRE( loaded.readBinary( begin, buffer.data() + buffer.size() ) );
+      REQUIRE( begin == buffer.data() + buffer.size() );
+      REQUIRE( loaded.getObject<Player>().name == "binary" );
+      REQUIRE( loaded.getObject<Player>().score == -3 );
+
+      begin = buffer.data();
+      REQUIRE( !loaded.readBinary( begin, buffer.data() + 8 ) );
+    }
+  }
+
+  GIVEN( "A type with hand written serializers and reflected fields" )
+  {
+    const MetaData& metaData = MetaData::get<VectorComponent>();
+
+    THEN( "The hand written serializers should still be used" )
+    {
+      Json::Value root{};
+      REQUIRE( metaData.getFields() != nullptr );
+      REQUIRE( Variant::create( VectorComponent{1, 2, 3} )
+                 .serialize( root ) );
+      REQUIRE( root["z"].asFloat() == 3.0f );
+    }
+
+    THEN( "The fields should drive the binary format" )
+    {
+      string buffer;
+      REQUIRE( Variant::create( VectorComponent{1, 2, 3} )
+                 .writeBinary( buffer ) );
+      REQUIRE( buffer.size() == 3 * sizeof( float ) );
+
+      Variant loaded{metaData};
+      const char* begin = buffer.data();
+      REQUIRE( loaded.readBinary( begin, buffer.data() + buffer.size() ) );
+      REQUIRE( loaded.getObject<VectorComponent>().getY() == 2.0f );
+    }
+
+    THEN( "Types without fields should not write binary" )
+    {
+      string buffer;
+      REQUIRE( !Variant::create( Widget{} ).writeBinary( buffer ) );
+      REQUIRE( !Variant{}.writeBinary( buffer ) );
+    }
+  }
+}
@@ -0,0 +1,109 @@
+#include <tetra/meta/MetaArray.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <cstdint>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+using test::VectorComponent;
+
+namespace
+{
+
+struct alignas( 64 ) CacheLine
+{
+  int value{0};
+};
+
+} /* namespace */
+
+SCENARIO( "Storing instances contiguously in a MetaArray",
+          "[MetaArray]" )
+{
+  GIVEN( "A MetaArray of VectorComponents" )
+  {
+    MetaArray array{MetaData::get<VectorComponent>()};
+    for ( int i = 0; i < 100; ++i )
+    {
+      reinterpret_cast<VectorComponent*>( array.emplaceBack() )
+        ->setX( float( i ) );
+    }
+
+    THEN( "The elements should be packed back to back" )
+    {
+      REQUIRE( array.size() == 100 );
+
+      auto* first = reinterpret_cast<VectorComponent*>( array.data() );
+      REQUIRE( array.at( 57 ) == first + 57 );
+      REQUIRE( first[99].getX() == 99.0f );
+    }
+
+    THEN( "swapRemove should move the last element into the hole" )
+    {
+      array.swapRemove( 10 );
+
+      REQUIRE( array.size() == 99 );
+      REQUIRE( reinterpret_cast<VectorComponent*>( array.at( 10 ) )
+                 ->getX() == 99.0f );
+    }
+
+    THEN( "shrinkToFit should keep the elements" )
+    {
+      array.popBack();
+      array.shrinkToFit();
+
+      REQUIRE( array.capacity() == 99 );
+      REQUIRE( reinterpret_cast<VectorComponent*>( array.at( 98 ) )
+                 ->getX() == 98.0f );
+    }
+  }
+
+  GIVEN( "A MetaArray of Widgets" )
+  {
+    {
+      MetaArray array{MetaData::get<Widget>()};
+      for ( int i = 0; i < 20; ++i ) array.emplaceBack();
+
+      THEN( "Growing the array should relocate, not copy, the "
+            "Widgets" )
+      {
+        REQUIRE( Widget::getInstanceCount() == 20 );
+      }
+
+      THEN( "Moving the array should transfer the elements" )
+      {
+        MetaArray moved{std::move( array )};
+
+        REQUIRE( array.empty() );
+        REQUIRE( moved.size() == 20 );
+        REQUIRE( Widget::getInstanceCount() == 20 );
+      }
+    }
+
+    THEN( "Destroying the array should destroy the Widgets" )
+    {
+      REQUIRE( Widget::getInstanceCount() == 0 );
+    }
+  }
+
+  GIVEN( "A MetaArray of an over-aligned type" )
+  {
+    MetaArray array{MetaData::get<CacheLine>()};
+    for ( int i = 0; i < 10; ++i ) array.emplaceBack();
+
+    THEN( "Every element should be aligned" )
+    {
+      bool aligned = true;
+      for ( size_t i = 0; i < array.size(); ++i )
+        aligned &=
+          reinterpret_cast<uintptr_t>( array.at( i ) ) % 64 == 0;
+
+      REQUIRE( aligned );
+    }
+  }
+}
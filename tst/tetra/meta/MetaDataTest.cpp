@@ -5,6 +5,7 @@
 #include <catch.hpp>
 #include <json/json.h>
 
+#include <cstdint>
 #include <iostream>
 #include <typeinfo>
 
@@ -14,6 +15,21 @@ using namespace tetra::meta;
 using test::Widget;
 using test::VectorComponent;
 
+namespace
+{
+
+struct alignas( 32 ) Vec8f
+{
+  float lanes[8];
+};
+
+struct alignas( 64 ) PaddedCounter
+{
+  long count{0};
+};
+
+} /* namespace */
+
 SCENARIO( "Creating MetaData for a VectorComponent",
           "[MetaData][Serialization]" )
 {
@@ -51,6 +67,13 @@ SCENARIO( "Creating MetaData for a VectorComponent",
       REQUIRE( vc.getZ() == 3.0f );
     }
 
+    THEN( "The layout of a VectorComponent should be reported" )
+    {
+      REQUIRE( metaData.getSize() == sizeof( VectorComponent ) );
+      REQUIRE( metaData.getAlignment() == alignof( VectorComponent ) );
+      REQUIRE( metaData.isTriviallyCopyable() );
+    }
+
     THEN( "We should be able to copy VectorComponents" )
     {
       VectorComponent* vec1 = reinterpret_cast<VectorComponent*>(
@@ -102,6 +125,28 @@ SCENARIO( "Creating MetaData for a Widget.", "[MetaData]" )
       REQUIRE( Widget::getInstanceCount() == 0 );
     }
 
+    THEN( "We should be able to construct, relocate and destroy "
+          "Widgets in place" )
+    {
+      REQUIRE( !metaData.isTriviallyCopyable() );
+
+      alignas( Widget ) char first[sizeof( Widget )];
+      alignas( Widget ) char second[sizeof( Widget )];
+
+      metaData.constructInstanceAt( first );
+      REQUIRE( Widget::getInstanceCount() == 1 );
+      const string name =
+        reinterpret_cast<Widget*>( first )->getMyName();
+
+      metaData.relocateInstance( second, first );
+      REQUIRE( Widget::getInstanceCount() == 1 );
+      REQUIRE( reinterpret_cast<Widget*>( second )->getMyName() ==
+               name );
+
+      metaData.destroyInstanceAt( second );
+      REQUIRE( Widget::getInstanceCount() == 0 );
+    }
+
     THEN(
       "All MetaData for a given type should be identically equal" )
     {
@@ -110,5 +155,48 @@ SCENARIO( "Creating MetaData for a Widget.", "[MetaData]" )
       REQUIRE( &metaData == &differentMetaData );
       REQUIRE( metaData == differentMetaData );
     }
+
+    THEN( "The type index should be unique to the Widget type" )
+    {
+      REQUIRE( metaData.getTypeIndex() < MetaData::getTypeCount() );
+      REQUIRE( metaData.getTypeIndex() !=
+               MetaData::get<VectorComponent>().getTypeIndex() );
+      REQUIRE( metaData.getTypeIndex() ==
+               MetaData::get<Widget>().getTypeIndex() );
+    }
+  }
+}
+
+SCENARIO( "Creating instances of over-aligned types", "[MetaData]" )
+{
+  GIVEN( "MetaData for types aligned for SIMD and to cache lines" )
+  {
+    const MetaData& vec = MetaData::get<Vec8f>();
+    const MetaData& counter = MetaData::get<PaddedCounter>();
+
+    THEN( "The alignment should be exposed" )
+    {
+      REQUIRE( vec.getAlignment() == 32 );
+      REQUIRE( counter.getAlignment() == 64 );
+    }
+
+    THEN( "Freestore instances should honour the alignment" )
+    {
+      bool aligned = true;
+      for ( int i = 0; i < 16; ++i )
+      {
+        void* first = vec.constructInstance();
+        void* second = counter.constructInstance();
+
+        aligned = aligned &&
+                  reinterpret_cast<uintptr_t>( first ) % 32 == 0 &&
+                  reinterpret_cast<uintptr_t>( second ) % 64 == 0;
+        REQUIRE( reinterpret_cast<PaddedCounter*>( second )->count == 0 );
+
+        vec.destroyInstance( first );
+        counter.destroyInstance( second );
+      }
+      REQUIRE( aligned );
+    }
   }
 }
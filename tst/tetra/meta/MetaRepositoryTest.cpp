@@ -181,3 +181,209 @@ SCENARIO(
   }
 }
 
+
+SCENARIO( "Using the MetaRepository to serialize and deserialize "
+          "batches of objects",
+          "[MetaRepository][Serialization]" )
+{
+  GIVEN( "A MetaRepository with VectorComponents and Widgets "
+         "registered" )
+  {
+    MetaRepository metaRepository{};
+    metaRepository.addType<VectorComponent>( "vector3d" );
+    metaRepository.addType<Widget>( "Widget" );
+
+    vector<Variant> variants;
+    variants.push_back(
+      Variant::create( VectorComponent{1.0f, 2.0f, 3.0f} ) );
+    variants.push_back(
+      Variant::create( VectorComponent{4.0f, 5.0f, 6.0f} ) );
+    variants.push_back( Variant{MetaData::get<Widget>()} );
+    variants.push_back(
+      Variant::create( VectorComponent{7.0f, 8.0f, 9.0f} ) );
+
+    THEN( "serializeMany should append one element per Variant" )
+    {
+      Json::Value array{};
+      metaRepository.serializeMany( variants.begin(), variants.end(),
+                                    array );
+      metaRepository.serializeMany( variants.begin(),
+                                    variants.begin() + 1, array );
+
+      REQUIRE( array.size() == 5 );
+      REQUIRE( array[1]["type"].asString() == "vector3d" );
+      REQUIRE( array[2]["type"].asString() == "Widget" );
+      REQUIRE( array[3]["object"]["z"].asFloat() == 9.0f );
+      REQUIRE( array[4]["object"]["x"].asFloat() == 1.0f );
+    }
+
+    THEN( "deserializeMany should round-trip the serialized array" )
+    {
+      Json::Value array{};
+      metaRepository.serializeMany( variants.begin(), variants.end(),
+                                    array );
+
+      vector<Variant> loaded = metaRepository.deserializeMany( array );
+
+      REQUIRE( loaded.size() == 4 );
+      REQUIRE( loaded[2].getMetaData() == MetaData::get<Widget>() );
+      REQUIRE( loaded[1].getObject<VectorComponent>().getY() ==
+               5.0f );
+      REQUIRE( loaded[3].getObject<VectorComponent>().getX() ==
+               7.0f );
+    }
+
+    THEN( "deserializeMany should throw on an unregistered type" )
+    {
+      Json::Value array{};
+      metaRepository.serializeMany( variants.begin(), variants.end(),
+                                    array );
+      array[3]["type"] = "not-a-type";
+
+      vector<Variant> loaded;
+      REQUIRE_THROWS_AS( metaRepository.deserializeMany(
+                           array, back_inserter( loaded ) ),
+                         TypeNotRegisteredException );
+      REQUIRE( loaded.size() == 3 );
+    }
+  }
+}
+
+SCENARIO( "Using the MetaRepository to deserialize into existing "
+          "Variants",
+          "[MetaRepository][Serialization]" )
+{
+  GIVEN( "A MetaRepository with VectorComponents and Widgets "
+         "registered" )
+  {
+    MetaRepository metaRepository{};
+    metaRepository.addType<VectorComponent>( "vector3d" );
+    metaRepository.addType<Widget>( "Widget" );
+
+    Json::Value root{};
+    metaRepository.serialize(
+      Variant::create( VectorComponent{1.0f, 2.0f, 3.0f} ), root );
+
+    THEN( "A Variant of the same type should be updated in place" )
+    {
+      Variant target = Variant::create( VectorComponent{} );
+      const VectorComponent* payload =
+        &target.getObject<VectorComponent>();
+
+      metaRepository.deserializeInto( target, root );
+
+      REQUIRE( &target.getObject<VectorComponent>() == payload );
+      REQUIRE( payload->getZ() == 3.0f );
+    }
+
+    THEN( "A Variant of a different type should be replaced" )
+    {
+      Variant target{MetaData::get<Widget>()};
+      metaRepository.deserializeInto( target, root );
+
+      REQUIRE( target.holds( MetaData::get<VectorComponent>() ) );
+      REQUIRE( target.getObject<VectorComponent>().getY() == 2.0f );
+      REQUIRE( Widget::getInstanceCount() == 0 );
+    }
+
+    THEN( "An empty Variant should receive a new payload" )
+    {
+      Variant target{};
+      REQUIRE( target.isEmpty() );
+
+      metaRepository.deserializeInto( target, root );
+
+      REQUIRE( !target.isEmpty() );
+      REQUIRE( target.getObject<VectorComponent>().getX() == 1.0f );
+    }
+
+    THEN( "An unregistered type should throw and leave the target "
+          "untouched" )
+    {
+      Variant target = Variant::create( VectorComponent{} );
+      root["type"] = "not-a-type";
+
+      REQUIRE_THROWS_AS( metaRepository.deserializeInto( target, root ),
+                         TypeNotRegisteredException );
+      REQUIRE( target.holds( MetaData::get<VectorComponent>() ) );
+    }
+  }
+}
+
+SCENARIO( "Using the MetaRepository without exceptions",
+          "[MetaRepository]" )
+{
+  GIVEN( "A MetaRepository with VectorComponents registered" )
+  {
+    MetaRepository metaRepository{};
+    metaRepository.addType<VectorComponent>( "vector3d" );
+
+    THEN( "findMetaData should return nullptr for unregistered types" )
+    {
+      REQUIRE( metaRepository.findMetaData( "Widget" ) == nullptr );
+      REQUIRE( metaRepository.findMetaData( "vector3d" ) ==
+               &MetaData::get<VectorComponent>() );
+    }
+
+    THEN( "findTypeName should return nullptr for unregistered types" )
+    {
+      REQUIRE( metaRepository.findTypeName(
+                 MetaData::get<Widget>() ) == nullptr );
+      REQUIRE( *metaRepository.findTypeName(
+                 MetaData::get<VectorComponent>() ) == "vector3d" );
+    }
+
+    THEN( "tryDeserialize should report unregistered types by return "
+          "value and leave the result untouched" )
+    {
+      Json::Value root{};
+      root["type"] = "Widget";
+
+      Variant result = Variant::create( 42 );
+      REQUIRE( !metaRepository.tryDeserialize( root, result ) );
+      REQUIRE( result.getObject<int>() == 42 );
+    }
+
+    THEN( "tryDeserialize should report malformed input by return "
+          "value and leave the result untouched" )
+    {
+      Json::Value array{Json::arrayValue};
+      array.append( 1 );
+      array.append( 2 );
+
+      Json::Value numberType{};
+      numberType["type"] = 5;
+
+      Json::Value arrayObject{};
+      arrayObject["type"] = "vector3d";
+      arrayObject["object"] = array;
+
+      Json::Value missingObject{};
+      missingObject["type"] = "vector3d";
+
+      Json::Value badField{};
+      badField["type"] = "vector3d";
+      badField["object"]["x"] = "abc";
+
+      Variant result = Variant::create( 42 );
+      REQUIRE( !metaRepository.tryDeserialize( Json::Value{5}, result ) );
+      REQUIRE( !metaRepository.tryDeserialize( array, result ) );
+      REQUIRE( !metaRepository.tryDeserialize( numberType, result ) );
+      REQUIRE( !metaRepository.tryDeserialize( arrayObject, result ) );
+      REQUIRE( !metaRepository.tryDeserialize( missingObject, result ) );
+      REQUIRE( !metaRepository.tryDeserialize( badField, result ) );
+      REQUIRE( result.getObject<int>() == 42 );
+    }
+
+    THEN( "tryDeserialize should deserialize registered types" )
+    {
+      Json::Value root{};
+      metaRepository.serialize(
+        Variant::create( VectorComponent{1.0f, 2.0f, 3.0f} ), root );
+
+      Variant result{};
+      REQUIRE( metaRepository.tryDeserialize( root, result ) );
+      REQUIRE( result.getObject<VectorComponent>().getY() == 2.0f );
+    }
+  }
+}
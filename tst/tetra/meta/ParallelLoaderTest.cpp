@@ -0,0 +1,114 @@
+#include <tetra/meta/ParallelLoader.hpp>
+
+#include <catch.hpp>
+#include <json/json.h>
+#include <test/VectorComponent.hpp>
+
+#include <algorithm>
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+namespace
+{
+
+string makeInput( int lineCount )
+{
+  MetaRepository repository{};
+  repository.addType<VectorComponent>( "vector3d" );
+
+  Json::FastWriter writer{};
+  string ndjson{};
+  for ( int i = 0; i < lineCount; ++i )
+  {
+    Json::Value root{};
+    repository.serialize(
+      Variant::create( VectorComponent{float( i ), 0.0f, 0.0f} ),
+      root );
+    ndjson += writer.write( root ); // writes the trailing newline
+  }
+
+  return ndjson;
+}
+
+} /* namespace */
+
+SCENARIO( "Loading newline delimited JSON with a ParallelLoader",
+          "[ParallelLoader][Serialization]" )
+{
+  GIVEN( "A MetaRepository with VectorComponents registered" )
+  {
+    MetaRepository repository{};
+    repository.addType<VectorComponent>( "vector3d" );
+
+    const int lineCount = 20000;
+    const string input = makeInput( lineCount );
+
+    THEN( "Loading in input order should preserve the line order" )
+    {
+      ParallelLoader loader{repository, 4};
+      vector<Variant> variants =
+        loader.load( input, ParallelLoader::Ordering::InputOrder );
+
+      REQUIRE( variants.size() == lineCount );
+      bool inOrder = true;
+      for ( int i = 0; i < lineCount; ++i )
+        inOrder &=
+          variants[i].getObject<VectorComponent>().getX() == i;
+      REQUIRE( inOrder );
+    }
+
+    THEN( "Loading unordered should return every line exactly once" )
+    {
+      ParallelLoader loader{repository, 4};
+      vector<Variant> variants =
+        loader.load( input, ParallelLoader::Ordering::Unordered );
+
+      REQUIRE( variants.size() == lineCount );
+      vector<bool> seen( lineCount, false );
+      for ( const auto& variant : variants )
+        seen[int( variant.getObject<VectorComponent>().getX() )] =
+          true;
+      REQUIRE( find( seen.begin(), seen.end(), false ) ==
+               seen.end() );
+    }
+
+    THEN( "A single threaded loader should skip blank lines" )
+    {
+      ParallelLoader loader{repository, 1};
+      vector<Variant> variants =
+        loader.load( "\n" + makeInput( 2 ) + "  \n" );
+
+      REQUIRE( variants.size() == 2 );
+      REQUIRE( variants[1].getObject<VectorComponent>().getX() ==
+               1.0f );
+    }
+
+    THEN( "Invalid JSON should throw a ParseException with the line "
+          "number" )
+    {
+      ParallelLoader loader{repository, 2};
+      try
+      {
+        loader.load( makeInput( 3 ) + "{ not json\n" );
+        FAIL( "expected a ParseException" );
+      }
+      catch ( const ParseException& e )
+      {
+        REQUIRE( e.getLineNumber() == 4 );
+      }
+    }
+
+    THEN( "Unregistered types should throw a "
+          "TypeNotRegisteredException" )
+    {
+      ParallelLoader loader{repository, 2};
+      REQUIRE_THROWS_AS(
+        loader.load( "{\"type\":\"Widget\"}\n" ),
+        TypeNotRegisteredException );
+    }
+  }
+}
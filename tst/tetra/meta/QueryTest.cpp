@@ -0,0 +1,78 @@
+#include <tetra/meta/ArchetypeStore.hpp>
+
+#include <catch.hpp>
+#include <test/VectorComponent.hpp>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+SCENARIO( "Evaluating cached queries over an ArchetypeStore",
+          "[Query][ArchetypeStore]" )
+{
+  GIVEN( "An ArchetypeStore with a query for VectorComponents and "
+         "ints created before any entities" )
+  {
+    ArchetypeStore store{};
+    const Query& query = store.query<VectorComponent, int>();
+
+    REQUIRE( query.getArchetypes().empty() );
+
+    for ( Entity entity = 0; entity < 100; ++entity )
+    {
+      store.add<VectorComponent>( entity );
+      if ( entity % 2 == 0 ) store.add<int>( entity );
+      if ( entity % 5 == 0 ) store.add<float>( entity );
+    }
+
+    THEN( "Archetypes created later should be matched incrementally" )
+    {
+      // {V, i} and {V, i, f}
+      REQUIRE( query.getArchetypes().size() == 2 );
+      REQUIRE( query.size() == 50 );
+    }
+
+    THEN( "Asking for the same types again should return the same "
+          "query" )
+    {
+      REQUIRE( ( &store.query<int, VectorComponent>() == &query ) );
+    }
+
+    THEN( "Types listed twice should count once" )
+    {
+      const Query& repeated = store.query<int, VectorComponent, int>();
+      REQUIRE( ( &repeated == &query ) );
+      REQUIRE( repeated.getTypes().size() == 2 );
+
+      const Query& floats = store.query<float, float>();
+      REQUIRE( floats.getTypes().size() == 1 );
+      REQUIRE( floats.size() == 20 );
+    }
+
+    THEN( "A query created later should match existing archetypes" )
+    {
+      const Query& floats = store.query<float>();
+      REQUIRE( floats.size() == 20 );
+      REQUIRE( floats.getArchetypes().size() == 2 );
+    }
+
+    THEN( "Adding and removing components should be reflected "
+          "without rebuilding the query" )
+    {
+      store.remove<int>( 0 );
+      store.add<int>( 1 );
+      store.removeAll( 2 );
+
+      REQUIRE( query.size() == 49 );
+
+      int visited = 0;
+      query.forEach<int>( [&]( Entity entity, int& ) {
+        ++visited;
+        REQUIRE( entity != 0 );
+        REQUIRE( entity != 2 );
+      } );
+      REQUIRE( visited == 49 );
+    }
+  }
+}
@@ -0,0 +1,256 @@
+#include <tetra/meta/Dispatcher.hpp>
+#include <tetra/meta/SerializationCache.hpp>
+#include <tetra/meta/VariantArena.hpp>
+#include <tetra/meta/VariantSpan.hpp>
+#include <tetra/meta/Visit.hpp>
+
+#include <catch.hpp>
+#include <json/json.h>
+#include <test/VectorComponent.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+SCENARIO( "Tracking changes to Variants", "[Variant]" )
+{
+  GIVEN( "A new Variant" )
+  {
+    Variant variant = Variant::create( VectorComponent{1, 2, 3} );
+
+    THEN( "It should start out dirty" )
+    {
+      REQUIRE( variant.isDirty() );
+      REQUIRE( !Variant{}.isDirty() );
+    }
+
+    WHEN( "It is marked clean" )
+    {
+      variant.markClean();
+
+      THEN( "Reads should keep it clean" )
+      {
+        REQUIRE( !variant.isDirty() );
+        REQUIRE( variant.getConstObject<VectorComponent>().getX() == 1 );
+        REQUIRE( variant.tryGetConstObject<int>() == nullptr );
+        REQUIRE( variant.getConstPayload() != nullptr );
+
+        Json::Value root{};
+        REQUIRE( variant.serialize( root ) );
+        REQUIRE( !variant.isDirty() );
+      }
+
+      THEN( "Mutable access should make it dirty" )
+      {
+        variant.getMutableObject<VectorComponent>().setX( 5 );
+        REQUIRE( variant.isDirty() );
+        REQUIRE( variant.getConstObject<VectorComponent>().getX() == 5 );
+      }
+
+      THEN( "Handing out writable payloads should make it dirty" )
+      {
+        variant.getObject<VectorComponent>();
+        REQUIRE( variant.isDirty() );
+
+        variant.markClean();
+        REQUIRE( variant.tryGetObject<int>() == nullptr );
+        REQUIRE( !variant.isDirty() );
+        variant.tryGetObject<VectorComponent>();
+        REQUIRE( variant.isDirty() );
+
+        variant.markClean();
+        variant.getPayload();
+        REQUIRE( variant.isDirty() );
+      }
+
+      THEN( "Access through a const Variant should not write to it" )
+      {
+        const Variant& view = variant;
+        REQUIRE( view.getObject<VectorComponent>().getX() == 1 );
+        REQUIRE( view.tryGetObject<VectorComponent>() != nullptr );
+        REQUIRE( view.getPayload() != nullptr );
+        visit<VectorComponent>( view, []( VectorComponent& ) {} );
+        REQUIRE( !variant.isDirty() );
+      }
+
+      THEN( "Deserializing and copying should make it dirty" )
+      {
+        Json::Value root{};
+        variant.serialize( root );
+        variant.deserialize( root );
+        REQUIRE( variant.isDirty() );
+
+        variant.markClean();
+        variant.copy( Variant::create( VectorComponent{} ) );
+        REQUIRE( variant.isDirty() );
+      }
+
+      THEN( "Moving it should make the destination dirty" )
+      {
+        Variant moved{std::move( variant )};
+        REQUIRE( moved.isDirty() );
+        REQUIRE( moved.getObject<VectorComponent>().getZ() == 3 );
+      }
+    }
+  }
+
+  GIVEN( "Clean and dirty Variants compacted into an arena" )
+  {
+    vector<Variant> variants;
+    variants.push_back( Variant::create( 'a' ) );
+    variants.push_back( Variant::create( 'b' ) );
+    variants.push_back( Variant::create( 'c' ) );
+    variants[1].markClean();
+
+    VariantArena arena{};
+    arena.compact( variants );
+
+    THEN( "The payloads and flags should be kept" )
+    {
+      REQUIRE( variants[0].isDirty() );
+      REQUIRE( !variants[1].isDirty() );
+      REQUIRE( variants[1].isInArena() );
+      REQUIRE( variants[1].getObject<char>() == 'b' );
+      REQUIRE( variants[2].getObject<char>() == 'c' );
+    }
+  }
+}
+
+SCENARIO( "Memoizing serialized Variants", "[SerializationCache]" )
+{
+  GIVEN( "A SerializationCache and some registered Variants" )
+  {
+    MetaRepository repository{};
+    repository.addType<VectorComponent>( "VectorComponent" );
+    SerializationCache cache{repository};
+
+    vector<Variant> variants;
+    for ( int i = 0; i < 4; ++i )
+      variants.push_back(
+        Variant::create( VectorComponent{float( i ), 0, 0} ) );
+
+    THEN( "The node should match MetaRepository::serialize" )
+    {
+      Json::Value expected{};
+      repository.serialize( variants[2], expected );
+
+      REQUIRE( cache.serialize( variants[2] ) == expected );
+      REQUIRE( !variants[2].isDirty() );
+      REQUIRE( cache.getMissCount() == 1 );
+      REQUIRE( cache.size() == 1 );
+    }
+
+    WHEN( "The Variants are snapshotted twice without changes" )
+    {
+      Json::Value first{};
+      Json::Value second{};
+      cache.serializeMany( variants.begin(), variants.end(), first );
+      cache.serializeMany( variants.begin(), variants.end(), second );
+
+      THEN( "The second snapshot should only use cached nodes" )
+      {
+        REQUIRE( first == second );
+        REQUIRE( cache.getMissCount() == 4 );
+        REQUIRE( cache.getHitCount() == 4 );
+      }
+    }
+
+    WHEN( "A Variant changes between snapshots" )
+    {
+      string before = cache.serializeText( variants[1] );
+      variants[1].getMutableObject<VectorComponent>().setY( 7 );
+      string after = cache.serializeText( variants[1] );
+
+      THEN( "Only it should be serialized again" )
+      {
+        REQUIRE( before != after );
+        REQUIRE( cache.serializeText( variants[1] ) == after );
+        REQUIRE( cache.getMissCount() == 2 );
+        REQUIRE( cache.getHitCount() == 1 );
+
+        Json::Value node{};
+        Json::Reader{}.parse( after, node );
+        REQUIRE( node["object"]["y"].asFloat() == 7.0f );
+      }
+    }
+
+    THEN( "Binary bytes should be cached and appended" )
+    {
+      string out;
+      REQUIRE( cache.writeBinary( variants[3], out ) );
+      REQUIRE( cache.writeBinary( variants[3], out ) );
+      REQUIRE( out.size() == 6 * sizeof( float ) );
+      REQUIRE( cache.getHitCount() == 1 );
+
+      string direct;
+      variants[3].writeBinary( direct );
+      REQUIRE( out.substr( 0, direct.size() ) == direct );
+
+      Variant text = Variant::create( string{"no fields"} );
+      REQUIRE( !cache.writeBinary( text, out ) );
+    }
+
+    THEN( "Writes through Dispatcher, visit and VariantSpan should be "
+          "serialized again" )
+    {
+      Dispatcher dispatcher{};
+      dispatcher.addHandler<VectorComponent>(
+        []( VectorComponent& vector ) { vector.setY( 1 ); } );
+
+      cache.serialize( variants[0] );
+      REQUIRE( dispatcher.dispatch( variants[0] ) );
+      REQUIRE( cache.serialize( variants[0] )["object"]["y"].asFloat() ==
+               1.0f );
+
+      cache.serialize( variants[1] );
+      visit<VectorComponent>( variants[1], []( VectorComponent& vector ) {
+        vector.setY( 2 );
+      } );
+      REQUIRE( cache.serialize( variants[1] )["object"]["y"].asFloat() ==
+               2.0f );
+
+      cache.serialize( variants[2] );
+      VariantSpan<VectorComponent> span{variants};
+      span[2].setY( 3 );
+      REQUIRE( cache.serialize( variants[2] )["object"]["y"].asFloat() ==
+               3.0f );
+
+      REQUIRE( cache.getHitCount() == 0 );
+      REQUIRE( cache.getMissCount() == 6 );
+    }
+
+    THEN( "Finishing a snapshot should drop Variants which were not in "
+          "it" )
+    {
+      Json::Value first{};
+      cache.serializeMany( variants.begin(), variants.end(), first );
+      REQUIRE( cache.finishSnapshot() == 0 );
+      REQUIRE( cache.size() == 4 );
+
+      variants.pop_back();
+      Json::Value second{};
+      cache.serializeMany( variants.begin(), variants.end(), second );
+      REQUIRE( cache.finishSnapshot() == 1 );
+      REQUIRE( cache.size() == 3 );
+      REQUIRE( cache.getHitCount() == 3 );
+    }
+
+    THEN( "Forgotten Variants should be serialized again" )
+    {
+      cache.serialize( variants[0] );
+      cache.forget( variants[0] );
+      REQUIRE( cache.size() == 0 );
+
+      cache.serialize( variants[0] );
+      REQUIRE( cache.getMissCount() == 2 );
+
+      cache.clear();
+      REQUIRE( cache.size() == 0 );
+    }
+  }
+}
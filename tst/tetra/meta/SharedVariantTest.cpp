@@ -0,0 +1,165 @@
+#include <tetra/meta/SharedVariant.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+
+namespace
+{
+
+/**
+ * Throws from its copy assignment while failCopies is set.
+ **/
+struct FragileCopy
+{
+  static bool failCopies;
+  int value{0};
+
+  FragileCopy() = default;
+  FragileCopy( const FragileCopy& ) = default;
+
+  FragileCopy& operator=( const FragileCopy& other )
+  {
+    if ( failCopies ) throw runtime_error{"copy failed"};
+    value = other.value;
+    return *this;
+  }
+};
+
+bool FragileCopy::failCopies = false;
+
+} /* namespace */
+
+SCENARIO( "Sharing one payload between SharedVariants",
+          "[SharedVariant]" )
+{
+  GIVEN( "A SharedVariant holding a string" )
+  {
+    SharedVariant shared = SharedVariant::create( string{"message"} );
+
+    THEN( "It should hold the payload" )
+    {
+      REQUIRE( !shared.isEmpty() );
+      REQUIRE( shared.getUseCount() == 1 );
+      REQUIRE( shared.holds( MetaData::get<string>() ) );
+      REQUIRE( shared.getObject<string>() == "message" );
+      REQUIRE( shared.tryGetObject<int>() == nullptr );
+      REQUIRE_THROWS_AS( shared.getObject<int>(), TypeCastException );
+      REQUIRE( shared.getMetaData() == &MetaData::get<string>() );
+      REQUIRE( shared.getConstPayload() == &shared.getObject<string>() );
+
+      SharedVariant empty{};
+      REQUIRE( empty.getMetaData() == nullptr );
+      REQUIRE( empty.getConstPayload() == nullptr );
+      REQUIRE( empty.tryGetObject<string>() == nullptr );
+    }
+
+    WHEN( "It is copied" )
+    {
+      SharedVariant copy = shared;
+
+      THEN( "The copies should share the payload" )
+      {
+        REQUIRE( shared.getUseCount() == 2 );
+        REQUIRE( &copy.getObject<string>() ==
+                 &shared.getObject<string>() );
+      }
+
+      THEN( "Mutable access should copy the payload first" )
+      {
+        copy.getMutableObject<string>() = "changed";
+
+        REQUIRE( shared.getObject<string>() == "message" );
+        REQUIRE( copy.getObject<string>() == "changed" );
+        REQUIRE( shared.getUseCount() == 1 );
+        REQUIRE( copy.getUseCount() == 1 );
+      }
+
+      THEN( "Releasing a shared payload should copy it" )
+      {
+        Variant released = copy.release();
+
+        REQUIRE( copy.isEmpty() );
+        REQUIRE( released.getObject<string>() == "message" );
+        REQUIRE( released.getPayload() != shared.getConstPayload() );
+      }
+    }
+
+    THEN( "Mutable access to an unshared payload should not copy it" )
+    {
+      const void* payload = shared.getConstPayload();
+      shared.getMutableObject<string>() += "!";
+
+      REQUIRE( shared.getConstPayload() == payload );
+      REQUIRE( shared.getObject<string>() == "message!" );
+    }
+
+    THEN( "Releasing an unshared payload should move it out" )
+    {
+      const void* payload = shared.getConstPayload();
+      Variant released = shared.release();
+
+      REQUIRE( released.getPayload() == payload );
+      REQUIRE( shared.isEmpty() );
+      REQUIRE( shared.getUseCount() == 0 );
+    }
+  }
+
+  GIVEN( "Widgets shared between threads" )
+  {
+    int widgets = Widget::getInstanceCount();
+    {
+      SharedVariant shared = SharedVariant::create( Widget{} );
+
+      vector<thread> threads;
+      for ( int i = 0; i < 4; ++i )
+      {
+        threads.emplace_back( [shared]() {
+          vector<SharedVariant> copies( 1000, shared );
+        } );
+      }
+      for ( auto& thread : threads ) thread.join();
+
+      REQUIRE( shared.getUseCount() == 1 );
+      REQUIRE( Widget::getInstanceCount() == widgets + 1 );
+    }
+
+    THEN( "The payload should be destroyed with the last handle" )
+    {
+      REQUIRE( Widget::getInstanceCount() == widgets );
+    }
+  }
+
+  GIVEN( "A shared payload whose copy throws" )
+  {
+    FragileCopy original{};
+    original.value = 7;
+    SharedVariant shared = SharedVariant::create( original );
+    SharedVariant copy = shared;
+    Variant target = Variant::create( string{"kept"} );
+    Variant source = Variant::create( original );
+
+    FragileCopy::failCopies = true;
+    REQUIRE_THROWS_AS( copy.getMutableObject<FragileCopy>(),
+                       runtime_error );
+    REQUIRE_THROWS_AS( target.copy( source ), runtime_error );
+    FragileCopy::failCopies = false;
+
+    THEN( "The handles and the target should be unchanged" )
+    {
+      REQUIRE( shared.getUseCount() == 2 );
+      REQUIRE( copy.getConstPayload() == shared.getConstPayload() );
+      REQUIRE( copy.getObject<FragileCopy>().value == 7 );
+      REQUIRE( target.getObject<string>() == "kept" );
+    }
+  }
+}
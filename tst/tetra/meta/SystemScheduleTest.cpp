@@ -0,0 +1,63 @@
+#include <tetra/meta/SystemSchedule.hpp>
+
+#include <catch.hpp>
+#include <test/VectorComponent.hpp>
+#include <test/Widget.hpp>
+
+#include <atomic>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+using test::Widget;
+
+SCENARIO( "Scheduling systems by their component accesses",
+          "[SystemSchedule]" )
+{
+  GIVEN( "Accesses to a few component types" )
+  {
+    Access readVector{};
+    readVector.read<VectorComponent>();
+    Access writeVector{};
+    writeVector.write<VectorComponent>();
+    Access writeWidget{};
+    writeWidget.read<VectorComponent>().write<Widget>();
+
+    THEN( "Only accesses with a write to a shared type conflict" )
+    {
+      REQUIRE( !readVector.conflictsWith( readVector ) );
+      REQUIRE( readVector.conflictsWith( writeVector ) );
+      REQUIRE( writeVector.conflictsWith( readVector ) );
+      REQUIRE( writeVector.conflictsWith( writeWidget ) );
+      REQUIRE( !readVector.conflictsWith( writeWidget ) );
+    }
+
+    WHEN( "Systems are added to a schedule" )
+    {
+      atomic<int> calls{0};
+      auto count = [&calls]( TaskScheduler& ) { ++calls; };
+
+      SystemSchedule schedule{};
+      schedule.add( "read", readVector, count );
+      schedule.add( "widget", writeWidget, count );
+      schedule.add( "write", writeVector, count );
+      schedule.add( "read again", readVector, count );
+
+      THEN( "Non-conflicting systems should share a phase" )
+      {
+        REQUIRE( schedule.getPhaseCount() == 3 );
+        REQUIRE( schedule.getPhase( 0 ).size() == 2 );
+        REQUIRE( schedule.getPhase( 1 )[0] == "write" );
+        REQUIRE( schedule.getPhase( 2 )[0] == "read again" );
+      }
+
+      THEN( "Running the schedule should call every system once" )
+      {
+        TaskScheduler scheduler{2};
+        schedule.run( scheduler );
+        REQUIRE( calls == 4 );
+      }
+    }
+  }
+}
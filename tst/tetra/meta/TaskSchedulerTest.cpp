@@ -0,0 +1,113 @@
+#include <tetra/meta/TaskScheduler.hpp>
+#include <tetra/meta/ParallelForEach.hpp>
+
+#include <catch.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+SCENARIO( "Running work in parallel with a TaskScheduler",
+          "[TaskScheduler]" )
+{
+  GIVEN( "A TaskScheduler with four threads" )
+  {
+    TaskScheduler scheduler{4};
+    REQUIRE( scheduler.getThreadCount() == 4 );
+
+    THEN( "parallelFor should visit every index exactly once" )
+    {
+      vector<atomic<int>> visits( 10000 );
+      for ( auto& count : visits ) count = 0;
+
+      scheduler.parallelFor( 0, visits.size(), 64,
+                             [&visits]( size_t first, size_t last ) {
+                               for ( size_t i = first; i < last; ++i )
+                                 ++visits[i];
+                             } );
+
+      bool once = true;
+      for ( auto& count : visits ) once = once && count == 1;
+      REQUIRE( once );
+    }
+
+    THEN( "Ranges should not be split below the grain" )
+    {
+      atomic<int> ranges{0};
+      atomic<bool> small{false};
+      scheduler.parallelFor( 0, 1000, 100,
+                             [&]( size_t first, size_t last ) {
+                               ++ranges;
+                               if ( last - first < 100 ) small = true;
+                             } );
+
+      REQUIRE( ranges <= 10 );
+      REQUIRE( !small );
+    }
+
+    THEN( "Nested parallel loops should complete" )
+    {
+      atomic<int> total{0};
+      scheduler.parallelFor( 0, 8, 1, [&]( size_t first, size_t last ) {
+        for ( size_t i = first; i < last; ++i )
+          scheduler.parallelFor( 0, 100, 10,
+                                 [&]( size_t from, size_t to ) {
+                                   total += int( to - from );
+                                 } );
+      } );
+
+      REQUIRE( total == 800 );
+    }
+
+    THEN( "An exception thrown by a task should reach the caller" )
+    {
+      vector<TaskScheduler::Task> tasks{
+        []() {}, []() { throw runtime_error{"task failed"}; }, []() {}};
+
+      REQUIRE_THROWS_AS( scheduler.run( tasks ), runtime_error );
+    }
+  }
+
+  GIVEN( "A ComponentStore with many components" )
+  {
+    TaskScheduler scheduler{3};
+    ComponentStore store{};
+    for ( Entity entity = 0; entity < 5000; ++entity )
+      store.add( entity, VectorComponent{float( entity ), 0, 0} );
+
+    THEN( "parallelForEach should update every component" )
+    {
+      parallelForEach<VectorComponent>(
+        scheduler, store, []( Entity entity, VectorComponent& vector ) {
+          vector.setY( vector.getX() + float( entity ) );
+        } );
+
+      bool updated = true;
+      for ( Entity entity = 0; entity < 5000; ++entity )
+        updated = updated &&
+                  store.get<VectorComponent>( entity )->getY() ==
+                    2.0f * entity;
+      REQUIRE( updated );
+    }
+  }
+
+  GIVEN( "A few element sizes" )
+  {
+    THEN( "The default grain should span whole cache lines" )
+    {
+      for ( size_t size : {1, 4, 12, 24, 64, 100} )
+      {
+        size_t grain = cacheFriendlyGrain( size );
+        REQUIRE( grain > 0 );
+        if ( 64 % size == 0 || size % 64 == 0 )
+          REQUIRE( ( ( grain * size ) % 64 == 0 ) );
+      }
+    }
+  }
+}
@@ -0,0 +1,150 @@
+#include <tetra/meta/VariantArena.hpp>
+
+#include <catch.hpp>
+#include <json/json.h>
+#include <test/Widget.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+using test::VectorComponent;
+
+namespace
+{
+
+/**
+ * Throws from its move constructor once movesLeft reaches 0, a
+ * negative movesLeft never throws.
+ **/
+struct FragileMove
+{
+  static int movesLeft;
+  int value{0};
+
+  FragileMove() = default;
+  FragileMove( const FragileMove& ) = default;
+  FragileMove& operator=( const FragileMove& ) = default;
+
+  FragileMove( FragileMove&& other ) : value{other.value}
+  {
+    if ( movesLeft == 0 ) throw runtime_error{"move failed"};
+    if ( movesLeft > 0 ) --movesLeft;
+  }
+};
+
+int FragileMove::movesLeft = -1;
+
+} /* namespace */
+
+SCENARIO( "Compacting Variant payloads into a VariantArena",
+          "[VariantArena]" )
+{
+  GIVEN( "Variants of mixed types compacted into an arena" )
+  {
+    int widgets = Widget::getInstanceCount();
+
+    VariantArena arena{};
+    vector<Variant> variants;
+    variants.push_back( Variant::create( 'a' ) );
+    variants.push_back( Variant::create( string( 100, 's' ) ) );
+    variants.push_back( Variant{} );
+    variants.push_back( Variant::create( VectorComponent{1, 2, 3} ) );
+    variants.push_back( Variant::create( Widget{} ) );
+    variants.push_back( Variant::create( 'b' ) );
+
+    REQUIRE( arena.compact( variants ) == 5 );
+
+    THEN( "Payloads should be in the arena, in order, with their values" )
+    {
+      REQUIRE( arena.getBlockCount() == 1 );
+      REQUIRE( variants[0].isInArena() );
+      REQUIRE( !variants[2].isInArena() );
+      REQUIRE( variants[0].getObject<char>() == 'a' );
+      REQUIRE( variants[1].getObject<string>() == string( 100, 's' ) );
+      REQUIRE( variants[3].getObject<VectorComponent>().getZ() == 3.0f );
+      REQUIRE( variants[5].getObject<char>() == 'b' );
+      REQUIRE( Widget::getInstanceCount() == widgets + 1 );
+
+      uintptr_t first =
+        reinterpret_cast<uintptr_t>( variants[0].getPayload() );
+      uintptr_t last =
+        reinterpret_cast<uintptr_t>( variants[5].getPayload() );
+      REQUIRE( first < last );
+      REQUIRE( ( last - first < 128 ) );
+    }
+
+    THEN( "Compacted Variants should behave like any other" )
+    {
+      Json::Value root{};
+      REQUIRE( variants[3].serialize( root ) );
+
+      Variant copy{};
+      copy.copy( variants[1] );
+      REQUIRE( !copy.isInArena() );
+      REQUIRE( copy.getObject<string>() == string( 100, 's' ) );
+
+      variants[4] = Variant::create( 5 );
+      REQUIRE( Widget::getInstanceCount() == widgets );
+
+      Variant moved = move( variants[1] );
+      REQUIRE( moved.isInArena() );
+      REQUIRE( variants[1].isEmpty() );
+    }
+
+    WHEN( "They are compacted again into another arena" )
+    {
+      VariantArena next{};
+      REQUIRE( next.compact( variants ) == 5 );
+
+      THEN( "They should keep their values" )
+      {
+        REQUIRE( variants[1].getObject<string>() == string( 100, 's' ) );
+        REQUIRE( variants[4].holds( MetaData::get<Widget>() ) );
+      }
+
+      variants.clear();
+    }
+
+    THEN( "Destroying the Variants should destroy the payloads" )
+    {
+      variants.clear();
+      REQUIRE( Widget::getInstanceCount() == widgets );
+    }
+  }
+
+  GIVEN( "Variants whose payloads can fail to move" )
+  {
+    vector<Variant> variants;
+    for ( int i = 0; i < 3; ++i )
+    {
+      FragileMove fragile{};
+      fragile.value = i;
+      variants.push_back( Variant::create( fragile ) );
+    }
+
+    VariantArena arena{};
+    FragileMove::movesLeft = 1;
+    REQUIRE_THROWS_AS( arena.compact( variants ), runtime_error );
+    FragileMove::movesLeft = -1;
+
+    THEN( "Payloads before the failure should be compacted and the rest "
+          "kept in place" )
+    {
+      REQUIRE( variants[0].isInArena() );
+      REQUIRE( !variants[1].isInArena() );
+      REQUIRE( !variants[2].isInArena() );
+
+      for ( int i = 0; i < 3; ++i )
+        REQUIRE( variants[i].getObject<FragileMove>().value == i );
+    }
+
+    variants.clear();
+  }
+}
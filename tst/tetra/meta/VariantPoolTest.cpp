@@ -0,0 +1,199 @@
+#include <tetra/meta/VariantPool.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+
+namespace
+{
+
+/**
+ * Throws from its default constructor while failNext is set, and from
+ * its copy assignment while failCopies is set.
+ **/
+struct Fragile
+{
+  static bool failNext;
+  static bool failCopies;
+
+  Fragile()
+  {
+    if ( failNext ) throw runtime_error{"construction failed"};
+  }
+
+  Fragile( const Fragile& ) = default;
+
+  Fragile& operator=( const Fragile& )
+  {
+    if ( failCopies ) throw runtime_error{"copy failed"};
+    return *this;
+  }
+};
+
+bool Fragile::failNext = false;
+bool Fragile::failCopies = false;
+
+} /* namespace */
+
+SCENARIO( "Referring to pooled objects by VariantHandle",
+          "[VariantPool]" )
+{
+  GIVEN( "A VariantPool with strings and ints" )
+  {
+    VariantPool pool{};
+    VariantHandle first = pool.create( string{"first"} );
+    VariantHandle second = pool.create( string{"second"} );
+    VariantHandle third = pool.create( string{"third"} );
+    VariantHandle number = pool.create( 42 );
+
+    THEN( "Handles should resolve to their objects" )
+    {
+      REQUIRE( sizeof( VariantHandle ) == 8 );
+      REQUIRE( !first.isNull() );
+      REQUIRE( VariantHandle{}.isNull() );
+      REQUIRE( pool.get<string>( second ) == "second" );
+      REQUIRE( pool.get<int>( number ) == 42 );
+      REQUIRE( pool.getMetaData( number ) == &MetaData::get<int>() );
+      REQUIRE( pool.size() == 4 );
+      REQUIRE( pool.size( MetaData::get<string>() ) == 3 );
+    }
+
+    THEN( "Handles of another type should not resolve" )
+    {
+      REQUIRE( pool.tryGet<int>( first ) == nullptr );
+      REQUIRE_THROWS_AS( pool.get<string>( number ), TypeCastException );
+    }
+
+    WHEN( "An object is destroyed" )
+    {
+      REQUIRE( pool.destroy( first ) );
+
+      THEN( "Its handle should dangle and the others stay valid" )
+      {
+        REQUIRE( !pool.isValid( first ) );
+        REQUIRE( pool.getPayload( first ) == nullptr );
+        REQUIRE( !pool.destroy( first ) );
+        REQUIRE( pool.get<string>( second ) == "second" );
+        REQUIRE( pool.get<string>( third ) == "third" );
+        REQUIRE( pool.size( MetaData::get<string>() ) == 2 );
+      }
+
+      THEN( "A reused slot should not resolve the old handle" )
+      {
+        VariantHandle reused = pool.create( string{"reused"} );
+
+        REQUIRE( reused.getSlot() == first.getSlot() );
+        REQUIRE( reused != first );
+        REQUIRE( pool.tryGet<string>( first ) == nullptr );
+        REQUIRE( pool.get<string>( reused ) == "reused" );
+      }
+
+      THEN( "Storage should stay packed" )
+      {
+        int count = 0;
+        pool.forEach<string>( [&]( VariantHandle handle, string& value ) {
+          REQUIRE( &pool.get<string>( handle ) == &value );
+          ++count;
+        } );
+        REQUIRE( count == 2 );
+
+        pool.shrinkToFit();
+        REQUIRE( pool.get<string>( third ) == "third" );
+      }
+    }
+  }
+
+  GIVEN( "Widgets copied into a pool" )
+  {
+    int widgets = Widget::getInstanceCount();
+    {
+      VariantPool pool{};
+      Variant widget = Variant::create( Widget{} );
+      VariantHandle handle = pool.copy( widget );
+
+      REQUIRE( pool.get<Widget>( handle ).getMyName() ==
+               widget.getObject<Widget>().getMyName() );
+      REQUIRE( Widget::getInstanceCount() == widgets + 2 );
+
+      pool.destroy( handle );
+      REQUIRE( Widget::getInstanceCount() == widgets + 1 );
+
+      pool.create<Widget>( Widget{} );
+      REQUIRE_THROWS_AS( pool.copy( Variant{} ), TypeCastException );
+    }
+
+    THEN( "The pool should destroy the objects it still owns" )
+    {
+      REQUIRE( Widget::getInstanceCount() == widgets );
+    }
+  }
+
+  GIVEN( "A type whose construction can fail" )
+  {
+    VariantPool pool{};
+    VariantHandle first = pool.create( MetaData::get<Fragile>() );
+    REQUIRE( pool.destroy( first ) );
+
+    WHEN( "Creating an object throws" )
+    {
+      Fragile::failNext = true;
+      REQUIRE_THROWS_AS( pool.create( MetaData::get<Fragile>() ),
+                         runtime_error );
+      Fragile::failNext = false;
+
+      THEN( "The pool should be unchanged and reuse the free slot" )
+      {
+        REQUIRE( pool.size( MetaData::get<Fragile>() ) == 0 );
+
+        VariantHandle second = pool.create( MetaData::get<Fragile>() );
+        REQUIRE( second.getSlot() == first.getSlot() );
+        REQUIRE( second.getGeneration() == first.getGeneration() + 1 );
+        REQUIRE( pool.isValid( second ) );
+        REQUIRE( pool.size( MetaData::get<Fragile>() ) == 1 );
+      }
+    }
+
+    WHEN( "Copying a value into a new object throws" )
+    {
+      Fragile value{};
+      Variant variant = Variant::create( value );
+
+      Fragile::failCopies = true;
+      REQUIRE_THROWS_AS( pool.create( value ), runtime_error );
+      REQUIRE_THROWS_AS( pool.copy( variant ), runtime_error );
+      Fragile::failCopies = false;
+
+      THEN( "The new objects should be destroyed again" )
+      {
+        REQUIRE( pool.size( MetaData::get<Fragile>() ) == 0 );
+        REQUIRE( pool.size() == 0 );
+      }
+    }
+  }
+
+  GIVEN( "Values which do not fit in a VariantHandle" )
+  {
+    THEN( "Making a handle from them should throw" )
+    {
+      REQUIRE_THROWS_AS(
+        VariantHandle::make( VariantHandle::maxTypeIndex + 1, 0, 1 ),
+        HandleOverflowException );
+      REQUIRE_THROWS_AS(
+        VariantHandle::make( 0, VariantHandle::maxSlot + 1, 1 ),
+        HandleOverflowException );
+
+      VariantHandle handle = VariantHandle::make(
+        VariantHandle::maxTypeIndex, VariantHandle::maxSlot, 7 );
+      REQUIRE( handle.getTypeIndex() == VariantHandle::maxTypeIndex );
+      REQUIRE( handle.getSlot() == VariantHandle::maxSlot );
+      REQUIRE( handle.getGeneration() == 7 );
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#include <tetra/meta/VariantQueue.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+
+#include <iterator>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+
+SCENARIO( "Passing Variants through a VariantQueue", "[VariantQueue]" )
+{
+  GIVEN( "A VariantQueue with room for four Variants" )
+  {
+    VariantQueue queue{3};
+    REQUIRE( queue.getCapacity() == 4 );
+
+    THEN( "Variants should be popped in the order they were pushed" )
+    {
+      for ( int i = 0; i < 4; ++i )
+        REQUIRE( queue.tryPush( Variant::create( i ) ) );
+
+      Variant out{};
+      for ( int i = 0; i < 4; ++i )
+      {
+        REQUIRE( queue.tryPop( out ) );
+        REQUIRE( out.getObject<int>() == i );
+      }
+      REQUIRE( !queue.tryPop( out ) );
+    }
+
+    THEN( "Pushing should move the payload without copying it" )
+    {
+      Variant widget = Variant::create( Widget{} );
+      void* payload = widget.getPayload();
+
+      REQUIRE( queue.tryPush( move( widget ) ) );
+      REQUIRE( widget.isEmpty() );
+
+      Variant out{};
+      REQUIRE( queue.tryPop( out ) );
+      REQUIRE( out.getPayload() == payload );
+    }
+
+    THEN( "Pushing to a full queue should fail and keep the Variant" )
+    {
+      for ( int i = 0; i < 4; ++i )
+        REQUIRE( queue.tryPush( Variant::create( i ) ) );
+
+      Variant extra = Variant::create( 4 );
+      REQUIRE( !queue.tryPush( move( extra ) ) );
+      REQUIRE( extra.getObject<int>() == 4 );
+    }
+
+    THEN( "popBatch should pop up to the requested count" )
+    {
+      for ( int i = 0; i < 3; ++i )
+        REQUIRE( queue.tryPush( Variant::create( i ) ) );
+
+      vector<Variant> batch;
+      REQUIRE( queue.popBatch( back_inserter( batch ), 2 ) == 2 );
+      REQUIRE( queue.popBatch( back_inserter( batch ), 8 ) == 1 );
+      REQUIRE( batch.size() == 3 );
+      REQUIRE( batch[2].getObject<int>() == 2 );
+    }
+  }
+
+  GIVEN( "Several producer threads" )
+  {
+    VariantQueue queue{64};
+    const int producers = 4;
+    const int perProducer = 5000;
+
+    vector<thread> threads;
+    for ( int producer = 0; producer < producers; ++producer )
+    {
+      threads.emplace_back( [&queue, producer]() {
+        for ( int i = 0; i < perProducer; ++i )
+        {
+          Variant variant = Variant::create( producer * perProducer + i );
+          while ( !queue.tryPush( move( variant ) ) )
+            this_thread::yield();
+        }
+      } );
+    }
+
+    vector<int> seen( producers * perProducer, 0 );
+    vector<int> last( producers, -1 );
+    bool ordered = true;
+    vector<Variant> batch;
+    for ( int received = 0; received < producers * perProducer; )
+    {
+      batch.clear();
+      received += int( queue.popBatch( back_inserter( batch ), 32 ) );
+      for ( auto& variant : batch )
+      {
+        int value = variant.getObject<int>();
+        ++seen[value];
+        ordered = ordered && value > last[value / perProducer];
+        last[value / perProducer] = value;
+      }
+    }
+
+    for ( auto& thread : threads ) thread.join();
+
+    THEN( "Every Variant should arrive once, in per-producer order" )
+    {
+      bool once = true;
+      for ( int count : seen ) once = once && count == 1;
+      REQUIRE( once );
+      REQUIRE( ordered );
+    }
+  }
+}
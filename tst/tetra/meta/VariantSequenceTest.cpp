@@ -0,0 +1,124 @@
+#include <tetra/meta/VariantSequence.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+using test::VectorComponent;
+
+namespace
+{
+
+struct alignas( 32 ) Wide
+{
+  double values[4];
+};
+
+} /* namespace */
+
+SCENARIO( "Packing records into a VariantSequence",
+          "[VariantSequence]" )
+{
+  GIVEN( "A sequence of mixed types" )
+  {
+    VariantSequence sequence{256};
+    sequence.append( 1 );
+    sequence.append( string{"two"} );
+    sequence.append( VectorComponent{3, 3, 3} );
+    sequence.append( Wide{} );
+    sequence.append( Variant::create( string{"five"} ) );
+    *reinterpret_cast<int*>( sequence.emplace( MetaData::get<int>() ) ) =
+      6;
+
+    THEN( "Iteration should visit the records in order" )
+    {
+      REQUIRE( sequence.size() == 6 );
+
+      auto it = sequence.begin();
+      REQUIRE( it->getObject<int>() == 1 );
+      REQUIRE( ( ++it )->getObject<string>() == "two" );
+      REQUIRE( ( ++it )->getObject<VectorComponent>().getX() == 3.0f );
+      REQUIRE( ( ++it )->holds( MetaData::get<Wide>() ) );
+      REQUIRE( ( ++it )->tryGetObject<string>() != nullptr );
+      REQUIRE( ( ++it )->getObject<int>() == 6 );
+      REQUIRE( ++it == sequence.end() );
+    }
+
+    THEN( "Payloads should keep their alignment" )
+    {
+      bool aligned = true;
+      for ( auto& record : sequence )
+      {
+        uintptr_t address =
+          reinterpret_cast<uintptr_t>( record.getPayload() );
+        aligned = aligned &&
+                  address % record.getMetaData().getAlignment() == 0;
+      }
+      REQUIRE( aligned );
+    }
+
+    THEN( "Typed access should check the type" )
+    {
+      REQUIRE( sequence.begin()->tryGetObject<string>() == nullptr );
+      REQUIRE_THROWS_AS( sequence.begin()->getObject<float>(),
+                         TypeCastException );
+      REQUIRE_THROWS_AS( sequence.append( Variant{} ),
+                         TypeCastException );
+    }
+  }
+
+  GIVEN( "A sequence spanning several blocks" )
+  {
+    int widgets = Widget::getInstanceCount();
+
+    VariantSequence sequence{512};
+    for ( int i = 0; i < 100; ++i )
+    {
+      sequence.append( i );
+      sequence.emplace( MetaData::get<Widget>() );
+    }
+    sequence.append( string( 1000, 'x' ) );
+    sequence.emplace( MetaData::get<Widget>() );
+
+    size_t reserved = sequence.getReservedBytes();
+    REQUIRE( reserved > 512 );
+    REQUIRE( Widget::getInstanceCount() == widgets + 101 );
+
+    WHEN( "It is cleared" )
+    {
+      sequence.clear();
+
+      THEN( "Payloads should be destroyed and blocks kept" )
+      {
+        REQUIRE( sequence.empty() );
+        REQUIRE( sequence.begin() == sequence.end() );
+        REQUIRE( Widget::getInstanceCount() == widgets );
+        REQUIRE( sequence.getReservedBytes() == reserved );
+      }
+
+      THEN( "Refilling it should reuse the blocks" )
+      {
+        for ( int i = 0; i < 100; ++i )
+        {
+          sequence.append( i );
+          sequence.emplace( MetaData::get<Widget>() );
+        }
+
+        int sum = 0;
+        for ( auto& record : sequence )
+        {
+          if ( int* value = record.tryGetObject<int>() ) sum += *value;
+        }
+        REQUIRE( sum == 4950 );
+        REQUIRE( sequence.getReservedBytes() == reserved );
+      }
+    }
+  }
+}
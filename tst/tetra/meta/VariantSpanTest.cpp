@@ -0,0 +1,83 @@
+#include <tetra/meta/VariantSpan.hpp>
+
+#include <catch.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::VectorComponent;
+
+SCENARIO( "Viewing Variants of one type through a VariantSpan",
+          "[VariantSpan]" )
+{
+  GIVEN( "Variants which all hold VectorComponents" )
+  {
+    vector<Variant> variants;
+    for ( int i = 0; i < 5; ++i )
+      variants.push_back(
+        Variant::create( VectorComponent{float( i ), 0, 0} ) );
+
+    VariantSpan<VectorComponent> span{variants};
+
+    THEN( "The span should expose the payloads as references" )
+    {
+      REQUIRE( span.size() == 5 );
+      REQUIRE( !span.empty() );
+      REQUIRE( span[3].getX() == 3.0f );
+      REQUIRE( &span[1] == &variants[1].getObject<VectorComponent>() );
+      REQUIRE( ( span.end() - span.begin() == 5 ) );
+      REQUIRE( span.begin()[4].getX() == 4.0f );
+    }
+
+    THEN( "Writes through the span should reach the Variants" )
+    {
+      for ( auto& vector : span ) vector.setY( vector.getX() * 2 );
+      REQUIRE( variants[2].getObject<VectorComponent>().getY() == 4.0f );
+    }
+
+    THEN( "The span should work with standard algorithms" )
+    {
+      auto largest = max_element(
+        span.begin(), span.end(),
+        []( const VectorComponent& lhs, const VectorComponent& rhs ) {
+          return lhs.getX() < rhs.getX();
+        } );
+      REQUIRE( ( largest - span.begin() == 4 ) );
+      REQUIRE( distance( span.begin(), span.end() ) == 5 );
+      REQUIRE( ( 2 + span.begin() == span.begin() + 2 ) );
+
+      sort( span.begin(), span.end(),
+            []( const VectorComponent& lhs, const VectorComponent& rhs ) {
+              return lhs.getX() > rhs.getX();
+            } );
+      for ( int i = 0; i < 5; ++i )
+        REQUIRE( span[i].getX() == float( 4 - i ) );
+    }
+
+    THEN( "A trusted span should see the same payloads" )
+    {
+      auto trusted = VariantSpan<VectorComponent>::trusted(
+        variants.data(), variants.data() + variants.size() );
+      REQUIRE( &trusted[0] == &span[0] );
+    }
+  }
+
+  GIVEN( "Variants with one of another type" )
+  {
+    vector<Variant> variants;
+    variants.push_back( Variant::create( VectorComponent{} ) );
+    variants.push_back( Variant::create( 5 ) );
+
+    THEN( "Creating a span should throw" )
+    {
+      REQUIRE_THROWS_AS( VariantSpan<VectorComponent>{variants},
+                         TypeCastException );
+      REQUIRE_NOTHROW( ( VariantSpan<VectorComponent>{
+        variants.data(), variants.data() + 1} ) );
+    }
+  }
+}
@@ -5,11 +5,56 @@
 #include <test/Widget.hpp>
 #include <test/VectorComponent.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 using namespace tetra;
 using namespace tetra::meta;
 using test::Widget;
 using test::VectorComponent;
 
+namespace keys
+{
+
+struct Key
+{
+  int id;
+  int ignored;
+};
+
+std::size_t metaHash( const Key& key )
+{
+  return std::hash<int>{}( key.id );
+}
+
+bool metaEqual( const Key& lhs, const Key& rhs )
+{
+  return lhs.id == rhs.id;
+}
+
+bool metaLess( const Key& lhs, const Key& rhs )
+{
+  return lhs.id < rhs.id;
+}
+
+/**
+ * Has no comparison operators, so std containers of it declare
+ * operator== and operator< which fail when instantiated.
+ **/
+struct Opaque
+{
+  int value;
+};
+
+} /* namespace keys */
+
+using keys::Key;
+using keys::Opaque;
+
 SCENARIO( "Serializing and Deserializing Variants",
           "[Variant][Serialization]" )
 {
@@ -102,6 +147,14 @@ SCENARIO(
         REQUIRE( variant.getObject<Widget>().getMyName() ==
                  "Widget{1}" );
       }
+
+      THEN( "tryGetObject should return the payload for the right type "
+            "and nullptr for any other type" )
+      {
+        REQUIRE( variant.tryGetObject<Widget>() ==
+                 &variant.getObject<Widget>() );
+        REQUIRE( variant.tryGetObject<VectorComponent>() == nullptr );
+      }
     }
 
     THEN( "When the Variant goes out of scope, whe should see the "
@@ -140,6 +193,12 @@ SCENARIO(
         REQUIRE_THROWS_AS( toMove.getObject<Widget>(),
                            TypeCastException );
       }
+
+      THEN( "The Variant that was moved from should always return "
+            "nullptr when tryGetObject is called." )
+      {
+        REQUIRE( toMove.tryGetObject<Widget>() == nullptr );
+      }
     }
 
     THEN(
@@ -150,3 +209,115 @@ SCENARIO(
   }
 }
 
+SCENARIO( "Hashing and comparing Variants", "[Variant]" )
+{
+  GIVEN( "Types with and without hash and comparison operators" )
+  {
+    THEN( "MetaData should detect the operations" )
+    {
+      REQUIRE( MetaData::get<Key>().canHash() );
+      REQUIRE( MetaData::get<Key>().canCompareEqual() );
+      REQUIRE( MetaData::get<Key>().canCompareLess() );
+      REQUIRE( MetaData::get<int>().canHash() );
+      REQUIRE( MetaData::get<std::string>().canHash() );
+      REQUIRE( MetaData::get<std::string>().canCompareLess() );
+
+      REQUIRE( !MetaData::get<Widget>().canHash() );
+      REQUIRE( !MetaData::get<Widget>().canCompareEqual() );
+      REQUIRE( !MetaData::get<VectorComponent>().canCompareLess() );
+    }
+
+    THEN( "Containers of types without comparisons should still be "
+          "registrable" )
+    {
+      const MetaData& vector = MetaData::get<std::vector<Opaque>>();
+      const MetaData& map = MetaData::get<std::map<int, Opaque>>();
+
+      REQUIRE( !vector.canHash() );
+      REQUIRE( !vector.canCompareEqual() );
+      REQUIRE( !vector.canCompareLess() );
+      REQUIRE( !map.canCompareEqual() );
+      REQUIRE( !map.canCompareLess() );
+
+      Variant opaque = Variant::create( std::vector<Opaque>{{1}} );
+      REQUIRE( opaque.getObject<std::vector<Opaque>>().size() == 1 );
+      REQUIRE_THROWS_AS( opaque == opaque,
+                         UnsupportedOperationException );
+    }
+
+    THEN( "Variants holding equal values should be equal" )
+    {
+      Variant a = Variant::create( Key{1, 10} );
+      Variant b = Variant::create( Key{1, 20} );
+      Variant c = Variant::create( Key{2, 10} );
+
+      REQUIRE( a == b );
+      REQUIRE( a != c );
+      REQUIRE( a.hash() == b.hash() );
+      REQUIRE( a < c );
+      REQUIRE( !( c < a ) );
+      REQUIRE( !( a < b ) );
+    }
+
+    THEN( "Variants of different types should never be equal" )
+    {
+      Variant number = Variant::create( 1 );
+      Variant wide = Variant::create( 1l );
+
+      REQUIRE( number != wide );
+      REQUIRE( number.hash() != wide.hash() );
+      REQUIRE( ( number < wide ) != ( wide < number ) );
+      REQUIRE( Variant::create( Widget{} ) !=
+               Variant::create( 1 ) );
+    }
+
+    THEN( "Empty Variants should be equal and order first" )
+    {
+      Variant empty{};
+      Variant number = Variant::create( 1 );
+
+      REQUIRE( empty == Variant{} );
+      REQUIRE( empty != number );
+      REQUIRE( empty < number );
+      REQUIRE( !( number < empty ) );
+      REQUIRE( empty.hash() == 0 );
+    }
+
+    THEN( "Unsupported operations should throw" )
+    {
+      Variant widget = Variant::create( Widget{} );
+      Variant other = Variant::create( Widget{} );
+
+      REQUIRE_THROWS_AS( widget.hash(), UnsupportedOperationException );
+      REQUIRE_THROWS_AS( widget == other, UnsupportedOperationException );
+      REQUIRE_THROWS_AS( widget < other, UnsupportedOperationException );
+    }
+  }
+
+  GIVEN( "A collection of Variants with duplicates" )
+  {
+    std::vector<std::string> names{"b", "a", "c", "a", "b"};
+
+    THEN( "An unordered_set should remove the duplicates" )
+    {
+      std::unordered_set<Variant> unique{};
+      for ( const auto& name : names )
+        unique.insert( Variant::create( std::string{name} ) );
+
+      REQUIRE( unique.size() == 3 );
+      REQUIRE( unique.count( Variant::create( std::string{"c"} ) ) ==
+               1 );
+    }
+
+    THEN( "Sorting should order the values" )
+    {
+      std::vector<Variant> sorted{};
+      for ( const auto& name : names )
+        sorted.push_back( Variant::create( std::string{name} ) );
+
+      std::sort( sorted.begin(), sorted.end() );
+      REQUIRE( sorted.front().getObject<std::string>() == "a" );
+      REQUIRE( sorted.back().getObject<std::string>() == "c" );
+    }
+  }
+}
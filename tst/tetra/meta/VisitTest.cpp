@@ -0,0 +1,63 @@
+#include <tetra/meta/Visit.hpp>
+
+#include <catch.hpp>
+#include <test/Widget.hpp>
+#include <test/VectorComponent.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace tetra;
+using namespace tetra::meta;
+using test::Widget;
+using test::VectorComponent;
+
+SCENARIO( "Visiting Variants with a closed set of types", "[Visit]" )
+{
+  GIVEN( "A visitor for ints, VectorComponents and strings" )
+  {
+    auto describe = overloaded(
+      []( int& i ) { return "int " + to_string( i ); },
+      []( VectorComponent& vec ) {
+        return "vector " + to_string( int( vec.getX() ) );
+      },
+      []( string& str ) { return "string " + str; } );
+
+    THEN( "Each listed type should reach its own overload" )
+    {
+      Variant number = Variant::create( 3 );
+      Variant vec = Variant::create( VectorComponent{4.0f, 0, 0} );
+      Variant str = Variant::create( string{"five"} );
+
+      REQUIRE( ( visit<int, VectorComponent, string>(
+                 number, describe ) == "int 3" ) );
+      REQUIRE( ( visit<int, VectorComponent, string>(
+                 vec, describe ) == "vector 4" ) );
+      REQUIRE( ( visit<int, VectorComponent, string>(
+                 str, describe ) == "string five" ) );
+    }
+
+    THEN( "The visitor should be able to modify the payload" )
+    {
+      Variant number = Variant::create( 3 );
+      visit<int, float>( number, overloaded( []( int& i ) { i = 9; },
+                                             []( float& ) {} ) );
+
+      REQUIRE( number.getObject<int>() == 9 );
+    }
+
+    THEN( "Types outside of the list should throw a "
+          "TypeCastException" )
+    {
+      Variant widget{MetaData::get<Widget>()};
+      Variant empty{};
+
+      REQUIRE_THROWS_AS( ( visit<int, VectorComponent, string>(
+                           widget, describe ) ),
+                         TypeCastException );
+      REQUIRE_THROWS_AS( ( visit<int, VectorComponent, string>(
+                           empty, describe ) ),
+                         TypeCastException );
+    }
+  }
+}